@@ -0,0 +1,48 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdint.h>
+
+// Number of 64-bit words needed for `bits`
+#define BITSET_WORDS(bits) (((bits) + 63) / 64)
+
+// Set bit
+static inline void bitset_set(uint64_t* bitset, int bit) {
+  bitset[bit >> 6] |= (uint64_t) 1 << (bit & 63);
+}
+
+// Test bit
+static inline int bitset_test(const uint64_t* bitset, int bit) {
+  return (bitset[bit >> 6] >> (bit & 63)) & 1;
+}
+
+// Count bits
+static inline int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(x);
+#else
+  // Portable fallback (SWAR)
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return (int) ((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Count bits in the intersection of two bitsets
+static inline int bitset_intersect_count(const uint64_t* a, const uint64_t* b, int words) {
+
+  // Initialize count
+  int count = 0;
+
+  // Loop over words
+  for(int w = 0; w < words; w++) {
+    count += popcount64(a[w] & b[w]);
+  }
+
+  // Return count
+  return count;
+
+}
+
+#endif /* BITSET_H */
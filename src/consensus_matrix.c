@@ -0,0 +1,179 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "bitset.h"
+
+/*
+
+ Co-assignment (consensus) matrix
+
+ For each variable and community, the iterations in which the
+ variable was assigned to that community are packed into a bitset.
+ The number of iterations two variables share a community is then
+ the sum of popcounts over their common communities' bitsets
+
+ Proportions below `threshold` are set to zero and whether the
+ matrix is binary (all zeros and ones) is checked in the same pass
+
+ Missing memberships (`NA` or less than 1) are never counted, which
+ matches `sum(x == y, na.rm = TRUE)`
+
+*/
+
+// Compute consensus matrix (returns 1 when binary)
+int consensus_matrix(
+    int* memberships, int iterations, int cols,
+    double threshold, int n_threads, double* output
+) {
+
+  // Initialize iterators
+  int i, j, t, c;
+
+  // Get maximum community
+  int communities = 0;
+  for(i = 0; i < iterations * cols; i++) {
+    if(memberships[i] != NA_INTEGER && memberships[i] > communities) {
+      communities = memberships[i];
+    }
+  }
+
+  // Words per bitset
+  int words = BITSET_WORDS(iterations);
+
+  // Initialize bitsets (variable x community x words)
+  uint64_t* bitsets = (uint64_t*) calloc(
+    (size_t) cols * communities * words, sizeof(uint64_t)
+  );
+
+  // Initialize communities used per variable
+  int* used = (int*) malloc((size_t) cols * communities * sizeof(int));
+  int* n_used = (int*) calloc(cols, sizeof(int));
+  char* in_use = (char*) calloc((size_t) cols * communities, sizeof(char));
+
+  // Pack memberships
+  for(j = 0; j < cols; j++) {
+    for(t = 0; t < iterations; t++) {
+
+      // Get community
+      c = memberships[t + j * iterations];
+
+      // Skip missing
+      if(c == NA_INTEGER || c < 1) {
+        continue;
+      }
+
+      // Zero-index community
+      c--;
+
+      // Set bit
+      bitset_set(&bitsets[((size_t) j * communities + c) * words], t);
+
+      // Track communities used
+      if(!in_use[j * communities + c]) {
+        in_use[j * communities + c] = 1;
+        used[j * communities + n_used[j]++] = c;
+      }
+
+    }
+  }
+
+  // Initialize binary flag
+  int non_binary = 0;
+
+  // Compute co-assignment
+  #pragma omp parallel for num_threads(n_threads) schedule(dynamic, 8) private(j, c) reduction(|:non_binary)
+  for(i = 0; i < cols; i++) {
+
+    for(j = i; j < cols; j++) {
+
+      // Initialize count
+      int count = 0;
+
+      // Loop over communities of variable i
+      for(int k = 0; k < n_used[i]; k++) {
+
+        // Get community
+        c = used[i * communities + k];
+
+        // Check for community in variable j
+        if(in_use[j * communities + c]) {
+          count += bitset_intersect_count(
+            &bitsets[((size_t) i * communities + c) * words],
+            &bitsets[((size_t) j * communities + c) * words],
+            words
+          );
+        }
+
+      }
+
+      // Compute proportion (division matches R)
+      double proportion = (double) count / iterations;
+
+      // Threshold values
+      if(proportion < threshold) {
+        proportion = 0.0;
+      }
+
+      // Check for binary
+      if(proportion != 0.0 && proportion != 1.0) {
+        non_binary = 1;
+      }
+
+      // Fill both triangles
+      output[i + (size_t) j * cols] = proportion;
+      output[j + (size_t) i * cols] = proportion;
+
+    }
+
+  }
+
+  // Free memory
+  free(bitsets);
+  free(used);
+  free(n_used);
+  free(in_use);
+
+  // Return binary flag
+  return !non_binary;
+
+}
+
+// Interface with R
+SEXP r_consensus_matrix(
+    SEXP r_memberships, SEXP r_threshold, SEXP r_ncores
+) {
+
+  // Get dimensions
+  int iterations = nrows(r_memberships);
+  int cols = ncols(r_memberships);
+
+  // Initialize R results
+  SEXP r_matrix = PROTECT(allocMatrix(REALSXP, cols, cols));
+  SEXP r_binary = PROTECT(allocVector(LGLSXP, 1));
+
+  // Call the C function
+  LOGICAL(r_binary)[0] = consensus_matrix(
+    INTEGER(r_memberships), iterations, cols,
+    REAL(r_threshold)[0], INTEGER(r_ncores)[0],
+    REAL(r_matrix)
+  );
+
+  // Set up result list
+  SEXP r_result = PROTECT(allocVector(VECSXP, 2));
+  SET_VECTOR_ELT(r_result, 0, r_matrix);
+  SET_VECTOR_ELT(r_result, 1, r_binary);
+
+  // Set names
+  SEXP r_names = PROTECT(allocVector(STRSXP, 2));
+  SET_STRING_ELT(r_names, 0, mkChar("consensus_matrix"));
+  SET_STRING_ELT(r_names, 1, mkChar("binary"));
+  setAttrib(r_result, R_NamesSymbol, r_names);
+
+  // Release protected SEXP objects
+  UNPROTECT(4);
+
+  // Return result
+  return r_result;
+
+}
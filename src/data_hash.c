@@ -0,0 +1,121 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Fast hash of data buffers (content addressing)
+
+ Atomic vectors (double, integer, logical, raw) are hashed over
+ their memory eight bytes at a time; strings hash their characters
+ and lists (e.g., data frames) hash each element in order. Hashes can be chained through `seed` and
+ are returned as 16 hexadecimal characters
+
+ Not a cryptographic hash: used to key caches of results computed
+ from the same data
+
+*/
+
+// Mix 64-bit value (splitmix64 finalizer)
+static inline uint64_t mix64(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Hash bytes
+static uint64_t hash_bytes(const unsigned char* bytes, size_t length, uint64_t hash) {
+
+  // Include length
+  hash = mix64(hash ^ (length * 0x9e3779b97f4a7c15ULL));
+
+  // Full words
+  size_t words = length / 8;
+  for(size_t w = 0; w < words; w++) {
+    uint64_t word;
+    memcpy(&word, &bytes[w * 8], 8);
+    hash = (hash ^ mix64(word)) * 0x9e3779b97f4a7c15ULL;
+    hash = (hash << 31) | (hash >> 33);
+  }
+
+  // Remaining bytes
+  uint64_t tail = 0;
+  memcpy(&tail, &bytes[words * 8], length - words * 8);
+  hash = (hash ^ mix64(tail)) * 0x9e3779b97f4a7c15ULL;
+
+  // Return hash
+  return mix64(hash);
+
+}
+
+// Hash R object
+static uint64_t hash_object(SEXP r_object, uint64_t hash) {
+
+  // Include type
+  hash = mix64(hash ^ (uint64_t) TYPEOF(r_object));
+
+  // Hash by type
+  switch(TYPEOF(r_object)) {
+    case REALSXP:
+      return hash_bytes(
+        (const unsigned char*) REAL(r_object),
+        (size_t) XLENGTH(r_object) * sizeof(double), hash
+      );
+    case INTSXP:
+      return hash_bytes(
+        (const unsigned char*) INTEGER(r_object),
+        (size_t) XLENGTH(r_object) * sizeof(int), hash
+      );
+    case LGLSXP:
+      return hash_bytes(
+        (const unsigned char*) LOGICAL(r_object),
+        (size_t) XLENGTH(r_object) * sizeof(int), hash
+      );
+    case RAWSXP:
+      return hash_bytes(RAW(r_object), (size_t) XLENGTH(r_object), hash);
+    case STRSXP:
+      for(R_xlen_t i = 0; i < XLENGTH(r_object); i++) {
+        SEXP r_string = STRING_ELT(r_object, i);
+        hash = (r_string == NA_STRING) ? mix64(hash ^ 0x4e41ULL) :
+          hash_bytes((const unsigned char*) CHAR(r_string), strlen(CHAR(r_string)), hash);
+      }
+      return hash;
+    case VECSXP:
+      for(R_xlen_t i = 0; i < XLENGTH(r_object); i++) {
+        hash = hash_object(VECTOR_ELT(r_object, i), hash);
+      }
+      return hash;
+    case NILSXP:
+      return hash;
+    default:
+      Rf_error("Only numeric, logical, character, raw, or list objects can be hashed. Terminating...");
+  }
+
+  // Not reached
+  return hash;
+
+}
+
+// Interface with R
+SEXP r_data_hash(SEXP r_object, SEXP r_seed) {
+
+  // Get seed (previous hash)
+  uint64_t seed = 0;
+  if(TYPEOF(r_seed) == STRSXP) {
+    seed = (uint64_t) strtoull(CHAR(STRING_ELT(r_seed, 0)), NULL, 16);
+  }
+
+  // Compute hash
+  uint64_t hash = hash_object(r_object, seed);
+
+  // Format hash
+  char formatted[17];
+  snprintf(formatted, sizeof(formatted), "%016llx", (unsigned long long) hash);
+
+  // Return hash
+  return mkString(formatted);
+
+}
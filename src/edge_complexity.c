@@ -0,0 +1,299 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "xoshiro.h"
+#include "nanotime.h"
+
+/*
+
+ Edge-sequence complexity for the Ergodicity Information Index
+
+ Edge encodings are exact signatures: each edge's values across
+ individuals (binary or weighted) are registered once in a hash
+ table and replaced by an integer code (no prime products, which
+ overflow in double precision beyond a few dozen individuals)
+
+ Each shuffle samples edges (columns of integer tokens) with
+ replacement and computes a Lempel-Ziv (LZ78) complexity directly
+ on the token sequence: the number of phrases c of the incremental
+ parsing gives a code length of c * (log2(c) + log2(alphabet)) bits,
+ reported in bytes (analogous to the length of a compressed string)
+
+ Shuffles run in parallel, each with its own xoshiro256++ stream
+
+*/
+
+// Hash table for LZ78 parsing: (phrase, symbol) -> phrase
+typedef struct {
+  uint64_t* keys;
+  int* values;
+  size_t size;
+} phrase_table;
+
+// Mix key (splitmix64 finalizer)
+static inline uint64_t mix_key(uint64_t key) {
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+  return key ^ (key >> 31);
+}
+
+// LZ78 complexity (bytes) of a token sequence
+static double lz_complexity(
+    const int* tokens, int n, int alphabet, phrase_table* table
+) {
+
+  // Reset table
+  memset(table->values, -1, table->size * sizeof(int));
+
+  // Initialize parsing
+  int phrases = 0;
+  int current = 0; // root phrase
+
+  // Parse sequence
+  for(int t = 0; t < n; t++) {
+
+    // Key of extension (phrase, symbol)
+    uint64_t key = ((uint64_t) current << 32) | (uint32_t) tokens[t];
+    size_t slot = mix_key(key) & (table->size - 1);
+
+    // Find extension (linear probing)
+    while(table->values[slot] != -1 && table->keys[slot] != key) {
+      slot = (slot + 1) & (table->size - 1);
+    }
+
+    // Check for known phrase
+    if(table->values[slot] != -1) {
+      current = table->values[slot];
+    }else{
+
+      // Add new phrase and restart at root
+      table->keys[slot] = key;
+      table->values[slot] = ++phrases;
+      current = 0;
+
+    }
+
+  }
+
+  // Incomplete last phrase
+  if(current != 0) {
+    phrases++;
+  }
+
+  // Return code length in bytes
+  return (phrases == 0) ? 0.0 :
+    phrases * (log2((double) phrases) + log2((double) alphabet)) / 8;
+
+}
+
+// Mean complexity of shuffled edge lists
+// `edges` are k x n tokens (column-major); columns are sampled
+static void shuffle_complexity(
+    const int* edges, int k, int n, int shuffles, uint64_t seed,
+    int n_threads, double* output
+) {
+
+  // Alphabet (largest token)
+  int alphabet = 1;
+  for(size_t t = 0; t < (size_t) k * n; t++) {
+    if(edges[t] >= alphabet) {
+      alphabet = edges[t] + 1;
+    }
+  }
+
+  // Complexity of each shuffle
+  double* complexity = (double*) malloc(shuffles * sizeof(double));
+
+  #pragma omp parallel num_threads(n_threads)
+  {
+
+    // Per thread memory
+    int length = k * n;
+    int* tokens = (int*) malloc((length > 0 ? length : 1) * sizeof(int));
+    phrase_table table;
+    table.size = 64;
+    while(table.size < (size_t) 2 * length) {
+      table.size <<= 1;
+    }
+    table.keys = (uint64_t*) malloc(table.size * sizeof(uint64_t));
+    table.values = (int*) malloc(table.size * sizeof(int));
+
+    #pragma omp for schedule(dynamic, 16)
+    for(int s = 0; s < shuffles; s++) {
+
+      // Stream of shuffle
+      xoshiro256_state state;
+      seed_xoshiro256(&state, seed + (uint64_t) s);
+
+      // Sample edges with replacement
+      for(int e = 0; e < n; e++) {
+        int column = (int) (next(&state) % n);
+        memcpy(&tokens[e * k], &edges[(size_t) column * k], k * sizeof(int));
+      }
+
+      // Complexity
+      complexity[s] = lz_complexity(tokens, length, alphabet, &table);
+
+    }
+
+    // Free memory
+    free(tokens);
+    free(table.keys);
+    free(table.values);
+
+  }
+
+  // Mean (in order)
+  double sum = 0.0;
+  for(int s = 0; s < shuffles; s++) {
+    sum += complexity[s];
+  }
+  *output = (shuffles > 0 && n > 0) ? sum / shuffles : NA_REAL;
+
+  // Free memory
+  free(complexity);
+
+}
+
+// Interface with R (edge signatures)
+// `r_values` are edges x individuals; returns the code of each edge:
+// 0 when all values are zero, otherwise 1, 2, ... in order of
+// first appearance (missing values are treated as equal)
+SEXP r_edge_signatures(SEXP r_values) {
+
+  // Get dimensions
+  int edges = nrows(r_values);
+  int individuals = ncols(r_values);
+  const double* values = REAL(r_values);
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocVector(INTSXP, edges));
+  int* codes = INTEGER(r_output);
+
+  // Initialize hash table (representative edge of each code)
+  size_t size = 64;
+  while(size < (size_t) 2 * edges) {
+    size <<= 1;
+  }
+  int* table = (int*) R_alloc(size, sizeof(int));
+  for(size_t slot = 0; slot < size; slot++) {
+    table[slot] = -1;
+  }
+  uint64_t* hashes = (uint64_t*) R_alloc(edges > 0 ? edges : 1, sizeof(uint64_t));
+
+  // Initialize codes
+  int n_codes = 0;
+
+  // Loop over edges
+  for(int e = 0; e < edges; e++) {
+
+    // Hash signature (FNV-1a over canonical values)
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    int all_zero = 1;
+    for(int i = 0; i < individuals; i++) {
+      double value = values[e + (size_t) i * edges];
+      uint64_t bits;
+      if(ISNAN(value)) {
+        bits = 0x7ff8000000000001ULL;
+        all_zero = 0;
+      }else{
+        value += 0.0; // -0 to 0
+        memcpy(&bits, &value, sizeof(double));
+        all_zero &= value == 0.0;
+      }
+      hash ^= bits;
+      hash *= 0x100000001b3ULL;
+    }
+    hashes[e] = hash;
+
+    // Check for no edge
+    if(all_zero) {
+      codes[e] = 0;
+      continue;
+    }
+
+    // Find signature (linear probing)
+    size_t slot = mix_key(hash) & (size - 1);
+    int found = -1;
+    while(table[slot] != -1) {
+
+      // Compare with representative
+      int other = table[slot];
+      if(hashes[other] == hash) {
+        int same = 1;
+        for(int i = 0; i < individuals && same; i++) {
+          double x = values[e + (size_t) i * edges];
+          double y = values[other + (size_t) i * edges];
+          same = (ISNAN(x) && ISNAN(y)) || x == y;
+        }
+        if(same) {
+          found = other;
+          break;
+        }
+      }
+
+      // Move to next slot
+      slot = (slot + 1) & (size - 1);
+
+    }
+
+    // Assign code
+    if(found == -1) {
+      table[slot] = e;
+      codes[e] = ++n_codes;
+    }else{
+      codes[e] = codes[found];
+    }
+
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
+
+// Interface with R (mean complexity over shuffles)
+// `r_edges` is a list of integer token matrices (k x edges);
+// returns the mean complexity of each
+SEXP r_edge_complexity(
+    SEXP r_edges, SEXP r_shuffles, SEXP r_seed, SEXP r_ncores
+) {
+
+  // Get values
+  int shuffles = INTEGER(r_shuffles)[0];
+  int n_threads = INTEGER(r_ncores)[0];
+
+  // Get seed
+  uint64_t seed_value = (uint64_t) REAL(r_seed)[0];
+
+  // For random seed, use zero
+  if(seed_value == 0) { // Use clocktime in nanoseconds
+    seed_value = get_time_ns();
+  }
+
+  // Initialize R result
+  int lists = length(r_edges);
+  SEXP r_output = PROTECT(allocVector(REALSXP, lists));
+
+  // Loop over edge lists (separate streams)
+  for(int l = 0; l < lists; l++) {
+    SEXP r_list = VECTOR_ELT(r_edges, l);
+    shuffle_complexity(
+      INTEGER(r_list), nrows(r_list), ncols(r_list), shuffles,
+      seed_value + (uint64_t) l * shuffles, n_threads, &REAL(r_output)[l]
+    );
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
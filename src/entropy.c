@@ -0,0 +1,396 @@
+#define USE_FC_LEN_T
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include <R_ext/Lapack.h>
+#include "xoshiro.h"
+#include "nanotime.h"
+#ifndef FCONE
+# define FCONE
+#endif
+
+/*
+
+ Von Neumann (spectral) entropy: -tr(rho log(rho))
+
+ Exact: eigenvalues only with LAPACK `dsyevr` (no eigenvectors)
+
+ Approximate: stochastic Lanczos quadrature (Ubaru, Chen & Saad, 2017).
+ The trace is estimated with Rademacher probes (Hutchinson) and each
+ quadratic form v' f(rho) v is approximated with a Lanczos
+ tridiagonalization started at v. Probes are added (up to 1000) until the 95%
+ half-width of the estimate is below `tolerance`
+
+ Eigenvalues at or below zero contribute zero, which matches
+ `-sum(values * log(values), na.rm = TRUE)` in R
+
+ Input is dense (column-major) or sparse (compressed column)
+
+*/
+
+// Maximum Lanczos steps
+#define LANCZOS_STEPS 40
+
+// Minimum and maximum number of probes
+#define MINIMUM_PROBES 10
+#define MAXIMUM_PROBES 1000
+
+// Symmetric matrix (dense or compressed column)
+typedef struct {
+  int n;
+  const double* dense;
+  const int* row_index;
+  const int* column_pointer;
+  const double* values;
+} entropy_matrix;
+
+// Entropy term
+static inline double entropy_term(double value, double log_base) {
+  return (value > 0.0) ? -value * log(value) / log_base : 0.0;
+}
+
+// Matrix-vector product (y = A x)
+static void entropy_matvec(const entropy_matrix* A, const double* x, double* y) {
+
+  // Initialize iterators
+  int i, j;
+  int n = A->n;
+
+  // Initialize output
+  memset(y, 0, n * sizeof(double));
+
+  // Check for sparse
+  if(A->dense == NULL) {
+
+    // Loop over columns
+    for(j = 0; j < n; j++) {
+      double value = x[j];
+      for(int k = A->column_pointer[j]; k < A->column_pointer[j + 1]; k++) {
+        y[A->row_index[k]] += A->values[k] * value;
+      }
+    }
+
+  }else{
+
+    // Loop over columns
+    for(j = 0; j < n; j++) {
+      double value = x[j];
+      const double* column = &A->dense[(size_t) j * n];
+      for(i = 0; i < n; i++) {
+        y[i] += column[i] * value;
+      }
+    }
+
+  }
+
+}
+
+// Exact entropy from eigenvalues (`dsyevr`, values only)
+static double entropy_exact(const entropy_matrix* A, double log_base) {
+
+  // Initialize iterators
+  int i, j;
+  int n = A->n;
+
+  // Copy matrix (overwritten by LAPACK)
+  double* a = (double*) calloc((size_t) n * n, sizeof(double));
+  if(A->dense == NULL) {
+    for(j = 0; j < n; j++) {
+      for(int k = A->column_pointer[j]; k < A->column_pointer[j + 1]; k++) {
+        a[A->row_index[k] + (size_t) j * n] = A->values[k];
+      }
+    }
+  }else{
+    memcpy(a, A->dense, (size_t) n * n * sizeof(double));
+  }
+
+  // Set up `dsyevr`
+  char jobz = 'N', range = 'A', uplo = 'L';
+  double vl = 0.0, vu = 0.0, abstol = 0.0, z = 0.0;
+  int il = 0, iu = 0, m = 0, ldz = 1, info = 0;
+  double* values = (double*) malloc(n * sizeof(double));
+  int* isuppz = (int*) malloc(2 * n * sizeof(int));
+
+  // Workspace query
+  double work_size;
+  int iwork_size, lwork = -1, liwork = -1;
+  F77_CALL(dsyevr)(
+    &jobz, &range, &uplo, &n, a, &n, &vl, &vu, &il, &iu, &abstol,
+    &m, values, &z, &ldz, isuppz, &work_size, &lwork, &iwork_size, &liwork,
+    &info FCONE FCONE FCONE
+  );
+
+  // Allocate workspace
+  lwork = (int) work_size;
+  liwork = iwork_size;
+  double* work = (double*) malloc(lwork * sizeof(double));
+  int* iwork = (int*) malloc(liwork * sizeof(int));
+
+  // Compute eigenvalues
+  F77_CALL(dsyevr)(
+    &jobz, &range, &uplo, &n, a, &n, &vl, &vu, &il, &iu, &abstol,
+    &m, values, &z, &ldz, isuppz, work, &lwork, iwork, &liwork,
+    &info FCONE FCONE FCONE
+  );
+
+  // Compute entropy
+  double entropy = 0.0;
+  if(info == 0) {
+    for(i = 0; i < m; i++) {
+      entropy += entropy_term(values[i], log_base);
+    }
+  }else{
+    entropy = NA_REAL;
+  }
+
+  // Free memory
+  free(a);
+  free(values);
+  free(isuppz);
+  free(work);
+  free(iwork);
+
+  // Return entropy
+  return entropy;
+
+}
+
+// Quadratic form v' f(A) v with Lanczos quadrature
+// `v` is a Rademacher probe (norm^2 = n)
+static double lanczos_quadrature(
+    const entropy_matrix* A, const double* v, int steps, double log_base,
+    double* Q, double* w, double* alpha, double* beta, double* eigenvectors,
+    double* work
+) {
+
+  // Initialize iterators
+  int i, j, k;
+  int n = A->n;
+  double norm = sqrt((double) n);
+
+  // First Lanczos vector
+  for(i = 0; i < n; i++) {
+    Q[i] = v[i] / norm;
+  }
+
+  // Initialize number of steps taken
+  int taken = 0;
+
+  // Lanczos iterations (full reorthogonalization)
+  for(j = 0; j < steps; j++) {
+
+    // Current vector
+    double* q = &Q[(size_t) j * n];
+
+    // w = A q
+    entropy_matvec(A, q, w);
+
+    // Diagonal
+    double a = 0.0;
+    for(i = 0; i < n; i++) {
+      a += w[i] * q[i];
+    }
+    alpha[j] = a;
+    taken++;
+
+    // Reorthogonalize against all previous vectors
+    for(k = 0; k <= j; k++) {
+      double* previous = &Q[(size_t) k * n];
+      double projection = 0.0;
+      for(i = 0; i < n; i++) {
+        projection += w[i] * previous[i];
+      }
+      for(i = 0; i < n; i++) {
+        w[i] -= projection * previous[i];
+      }
+    }
+
+    // Off-diagonal
+    double b = 0.0;
+    for(i = 0; i < n; i++) {
+      b += w[i] * w[i];
+    }
+    b = sqrt(b);
+
+    // Check for invariant subspace or last step
+    if(j == steps - 1 || b <= 1e-12 * fabs(a) || b == 0.0) {
+      break;
+    }
+
+    // Next vector
+    beta[j] = b;
+    double* next = &Q[(size_t) (j + 1) * n];
+    for(i = 0; i < n; i++) {
+      next[i] = w[i] / b;
+    }
+
+  }
+
+  // Eigendecomposition of tridiagonal matrix (`dstev`)
+  char jobz = 'V';
+  int info = 0;
+  F77_CALL(dstev)(
+    &jobz, &taken, alpha, beta, eigenvectors, &taken, work, &info FCONE
+  );
+
+  // Check for failure
+  if(info != 0) {
+    return NA_REAL;
+  }
+
+  // Gauss quadrature (weights are squared first components)
+  double quadrature = 0.0;
+  for(k = 0; k < taken; k++) {
+    double tau = eigenvectors[(size_t) k * taken];
+    quadrature += tau * tau * entropy_term(alpha[k], log_base);
+  }
+
+  // Return quadratic form (scaled by probe norm)
+  return n * quadrature;
+
+}
+
+// Approximate entropy with stochastic Lanczos quadrature
+static double entropy_approximate(
+    const entropy_matrix* A, double log_base, double tolerance,
+    xoshiro256_state* state
+) {
+
+  // Initialize iterators
+  int i;
+  int n = A->n;
+
+  // Lanczos steps (cannot exceed dimension)
+  int steps = (n < LANCZOS_STEPS) ? n : LANCZOS_STEPS;
+
+  // Initialize memory
+  double* v = (double*) malloc(n * sizeof(double));
+  double* Q = (double*) malloc((size_t) n * steps * sizeof(double));
+  double* w = (double*) malloc(n * sizeof(double));
+  double* alpha = (double*) malloc(steps * sizeof(double));
+  double* beta = (double*) malloc(steps * sizeof(double));
+  double* eigenvectors = (double*) malloc((size_t) steps * steps * sizeof(double));
+  double* work = (double*) malloc(2 * steps * sizeof(double));
+
+  // Running mean and variance (Welford)
+  double mean = 0.0, squares = 0.0;
+  int probes = 0;
+  uint64_t bits = 0;
+  int remaining = 0;
+
+  // Add probes until the 95% half-width is within tolerance
+  while(probes < MAXIMUM_PROBES) {
+
+    // Rademacher probe (one random bit per element)
+    for(i = 0; i < n; i++) {
+      if(remaining == 0) {
+        bits = next(state);
+        remaining = 64;
+      }
+      v[i] = (bits & 1) ? 1.0 : -1.0;
+      bits >>= 1;
+      remaining--;
+    }
+
+    // Quadratic form
+    double estimate = lanczos_quadrature(
+      A, v, steps, log_base, Q, w, alpha, beta, eigenvectors, work
+    );
+
+    // Check for failure
+    if(ISNAN(estimate)) {
+      mean = NA_REAL;
+      break;
+    }
+
+    // Update mean and variance
+    probes++;
+    double delta = estimate - mean;
+    mean += delta / probes;
+    squares += delta * (estimate - mean);
+
+    // Check for convergence
+    if(
+      probes >= MINIMUM_PROBES &&
+      1.959964 * sqrt(squares / (probes - 1) / probes) <= tolerance
+    ) {
+      break;
+    }
+
+  }
+
+  // Free memory
+  free(v);
+  free(Q);
+  free(w);
+  free(alpha);
+  free(beta);
+  free(eigenvectors);
+  free(work);
+
+  // Return entropy
+  return mean;
+
+}
+
+// Interface with R
+// `r_matrix` is a dense matrix or a list with compressed column
+// `i` (row indices), `p` (column pointers), `x` (values) and `n`
+SEXP r_spectral_entropy(
+    SEXP r_matrix, SEXP r_base, SEXP r_tolerance, SEXP r_seed
+) {
+
+  // Set up matrix
+  entropy_matrix A;
+
+  // Check for sparse
+  if(isNewList(r_matrix)) {
+    A.n = INTEGER(VECTOR_ELT(r_matrix, 3))[0];
+    A.dense = NULL;
+    A.row_index = INTEGER(VECTOR_ELT(r_matrix, 0));
+    A.column_pointer = INTEGER(VECTOR_ELT(r_matrix, 1));
+    A.values = REAL(VECTOR_ELT(r_matrix, 2));
+  }else{
+    A.n = ncols(r_matrix);
+    A.dense = REAL(r_matrix);
+    A.row_index = NULL;
+    A.column_pointer = NULL;
+    A.values = NULL;
+  }
+
+  // Get values
+  double log_base = log(REAL(r_base)[0]);
+  double tolerance = REAL(r_tolerance)[0];
+
+  // Initialize result
+  double entropy;
+
+  // Check for exact
+  if(tolerance <= 0.0 || A.n == 0) {
+    entropy = (A.n == 0) ? 0.0 : entropy_exact(&A, log_base);
+  }else{
+
+    // Get seed
+    uint64_t seed_value = (uint64_t) REAL(r_seed)[0];
+
+    // For random seed, use zero
+    if(seed_value == 0) { // Use clocktime in nanoseconds
+      seed_value = get_time_ns();
+    }
+
+    // Seed the random number generator
+    xoshiro256_state state;
+    seed_xoshiro256(&state, seed_value);
+
+    // Approximate entropy
+    entropy = entropy_approximate(&A, log_base, tolerance, &state);
+
+  }
+
+  // Return result
+  return ScalarReal(entropy);
+
+}
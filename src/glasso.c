@@ -0,0 +1,594 @@
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Graphical lasso path with EBIC selection
+
+ Block coordinate descent follows the `glasso` Fortran routine
+ (Friedman, Hastie & Tibshirani, 2008) including its convergence
+ thresholds. Lambdas are visited from largest to smallest and each
+ solution is warm-started from the previous one (covariance `W` and
+ regression coefficients `B`)
+
+ For each lambda, the log-likelihood (log-determinant from a
+ Cholesky factor and trace of `S %*% K`) and edge count are computed
+ from the current precision matrix; only the precision matrix with
+ the best EBIC is kept, so memory is O(p^2) rather than O(p^2 * nlambda)
+
+ For each lambda, the solution is block-diagonal over the connected
+ components of |S| > lambda (Witten, Friedman & Simon, 2011; Mazumder
+ & Hastie, 2012). Components are solved independently (in parallel)
+ and singletons are solved analytically (1 / W_jj)
+
+*/
+
+// Lasso for one column (coordinate descent on `W11 x = s12`)
+// `j` is the column excluded from `W`
+static void glasso_lasso(
+    const double* W, const double* s, const double* rho,
+    int p, int j, double threshold, int maxit, double* x, double* z
+) {
+
+  // Initialize iterators
+  int k, l, iteration = 0;
+
+  // Residuals (z = s12 - W11 x)
+  for(k = 0; k < p; k++) {
+    z[k] = s[k];
+  }
+
+  // Subtract fitted values (by column over non-zero coefficients)
+  for(l = 0; l < p; l++) {
+    if(l != j && x[l] != 0.0) {
+      const double* column = &W[(size_t) l * p];
+      for(k = 0; k < p; k++) {
+        z[k] -= column[k] * x[l];
+      }
+    }
+  }
+
+  // Coordinate descent
+  while(iteration < maxit) {
+
+    // Increase iteration
+    iteration++;
+
+    // Initialize maximum change
+    double change = 0.0;
+
+    // Loop over coordinates
+    for(k = 0; k < p; k++) {
+
+      // Skip column
+      if(k == j) {
+        continue;
+      }
+
+      // Previous value
+      double previous = x[k];
+      double diagonal = W[k + (size_t) k * p];
+
+      // Soft-threshold
+      double t = z[k] + diagonal * previous;
+      double magnitude = fabs(t) - rho[k];
+      x[k] = (magnitude > 0.0) ? copysign(magnitude, t) / diagonal : 0.0;
+
+      // Check for change
+      if(x[k] == previous) {
+        continue;
+      }
+
+      // Update residuals
+      double delta = x[k] - previous;
+      if(fabs(delta) > change) {
+        change = fabs(delta);
+      }
+
+      const double* column = &W[(size_t) k * p];
+      for(l = 0; l < p; l++) {
+        z[l] -= delta * column[l];
+      }
+
+    }
+
+    // Check for convergence
+    if(change < threshold) {
+      break;
+    }
+
+  }
+
+}
+
+// Solve graphical lasso for one (packed) block
+// `W` and `B` hold the warm start and are updated in place
+// Returns the number of iterations
+static int glasso_block(
+    const double* S, const double* rho, int p,
+    double shrink, double threshold, int maxit,
+    double* W, double* B, double* K, double* z
+) {
+
+  // Initialize iterators
+  int i, j, k, iteration = 0;
+
+  // Block coordinate descent
+  while(iteration < maxit) {
+
+    // Increase iteration
+    iteration++;
+
+    // Initialize change
+    double change = 0.0;
+
+    // Loop over columns
+    for(j = 0; j < p; j++) {
+
+      // Coefficients of column
+      double* x = &B[(size_t) j * p];
+      double* w = &W[(size_t) j * p];
+
+      // Solve lasso
+      glasso_lasso(
+        W, &S[(size_t) j * p], &rho[(size_t) j * p],
+        p, j, threshold, maxit, x, z
+      );
+
+      // Compute w12 = W11 x (by column over non-zero coefficients)
+      for(k = 0; k < p; k++) {
+        z[k] = 0.0;
+      }
+      for(i = 0; i < p; i++) {
+        if(i != j && x[i] != 0.0) {
+          const double* column = &W[(size_t) i * p];
+          for(k = 0; k < p; k++) {
+            z[k] += column[k] * x[i];
+          }
+        }
+      }
+
+      // Update covariance
+      for(k = 0; k < p; k++) {
+
+        // Skip column
+        if(k == j) {
+          continue;
+        }
+
+        // Update change
+        change += fabs(z[k] - w[k]);
+
+        // Set symmetric values
+        w[k] = z[k];
+        W[j + (size_t) k * p] = z[k];
+
+      }
+
+    }
+
+    // Check for convergence
+    if(change < shrink) {
+      break;
+    }
+
+  }
+
+  // Compute precision matrix
+  for(j = 0; j < p; j++) {
+
+    // Coefficients of column
+    const double* x = &B[(size_t) j * p];
+    const double* w = &W[(size_t) j * p];
+
+    // Diagonal
+    double value = w[j];
+    for(k = 0; k < p; k++) {
+      if(k != j) {
+        value -= w[k] * x[k];
+      }
+    }
+    double diagonal = 1.0 / value;
+
+    // Column
+    for(k = 0; k < p; k++) {
+      K[k + (size_t) j * p] = (k == j) ? diagonal : -diagonal * x[k];
+    }
+
+  }
+
+  // Symmetrize with upper triangle (same as `Matrix::forceSymmetric`)
+  for(j = 0; j < p; j++) {
+    for(k = j + 1; k < p; k++) {
+      K[k + (size_t) j * p] = K[j + (size_t) k * p];
+    }
+  }
+
+  // Return iterations
+  return iteration;
+
+}
+
+// Find root of node (union-find with path halving)
+static inline int component_root(int* parent, int node) {
+
+  // Move up to root
+  while(parent[node] != node) {
+    parent[node] = parent[parent[node]];
+    node = parent[node];
+  }
+
+  // Return root
+  return node;
+
+}
+
+// Solve graphical lasso for one penalty matrix
+// `W` and `B` hold the warm start and are updated in place
+static void glasso_solve(
+    const double* S, const double* rho, int p,
+    int penalize_diagonal, double thr, int maxit, int n_threads,
+    double* W, double* B, double* K
+) {
+
+  // Initialize iterators
+  int i, j, k;
+  size_t elements = (size_t) p * p;
+
+  // Set diagonal of covariance
+  for(j = 0; j < p; j++) {
+    W[j + (size_t) j * p] = S[j + (size_t) j * p] +
+      (penalize_diagonal ? rho[j + (size_t) j * p] : 0.0);
+  }
+
+  // Sum of absolute off-diagonal values
+  double shrink = 0.0;
+  for(i = 0; i < (int) elements; i++) {
+    shrink += fabs(S[i]);
+  }
+  for(j = 0; j < p; j++) {
+    shrink -= fabs(S[j + (size_t) j * p]);
+  }
+
+  // Convergence thresholds (same as `glasso` and shared across blocks)
+  double threshold = 0.0;
+  if(p > 1) {
+    shrink = thr * shrink / (p - 1);
+    threshold = shrink / p;
+    if(threshold < 2 * DBL_EPSILON) {
+      threshold = 2 * DBL_EPSILON;
+    }
+  }
+
+  // Screen into connected components of |S| > rho
+  // (the solution is block-diagonal over these components)
+  int* parent = (int*) malloc(p * sizeof(int));
+  for(j = 0; j < p; j++) {
+    parent[j] = j;
+  }
+  for(j = 0; j < p; j++) {
+    for(i = j + 1; i < p; i++) {
+      if(fabs(S[i + (size_t) j * p]) > rho[i + (size_t) j * p]) {
+        int root_i = component_root(parent, i);
+        int root_j = component_root(parent, j);
+        if(root_i != root_j) {
+          parent[root_i] = root_j;
+        }
+      }
+    }
+  }
+
+  // Component labels and sizes
+  int* component = (int*) malloc(p * sizeof(int));
+  int* label = (int*) malloc(p * sizeof(int));
+  int* size = (int*) calloc(p, sizeof(int));
+  int components = 0;
+  for(j = 0; j < p; j++) {
+    label[j] = -1;
+  }
+  for(j = 0; j < p; j++) {
+    int root = component_root(parent, j);
+    if(label[root] == -1) {
+      label[root] = components++;
+    }
+    component[j] = label[root];
+    size[component[j]]++;
+  }
+
+  // Members of each component (contiguous)
+  int* start = (int*) malloc((components + 1) * sizeof(int));
+  int* members = (int*) malloc(p * sizeof(int));
+  int* fill = (int*) calloc(components, sizeof(int));
+  start[0] = 0;
+  for(i = 0; i < components; i++) {
+    start[i + 1] = start[i] + size[i];
+  }
+  for(j = 0; j < p; j++) {
+    members[start[component[j]] + fill[component[j]]++] = j;
+  }
+
+  // Remove warm start values across components
+  // and initialize precision matrix
+  memset(K, 0, elements * sizeof(double));
+  for(j = 0; j < p; j++) {
+    for(k = 0; k < p; k++) {
+      if(component[k] != component[j]) {
+        W[k + (size_t) j * p] = 0.0;
+        B[k + (size_t) j * p] = 0.0;
+      }
+    }
+  }
+
+  // Order blocks from largest to smallest (singletons are analytic)
+  int* order = (int*) malloc(components * sizeof(int));
+  int blocks = 0;
+  for(i = 0; i < components; i++) {
+    if(size[i] == 1) {
+      j = members[start[i]];
+      K[j + (size_t) j * p] = 1.0 / W[j + (size_t) j * p];
+    }else{
+      order[blocks++] = i;
+    }
+  }
+  for(i = 1; i < blocks; i++) {
+    int current = order[i];
+    for(k = i - 1; k >= 0 && size[order[k]] < size[current]; k--) {
+      order[k + 1] = order[k];
+    }
+    order[k + 1] = current;
+  }
+
+  // Solve blocks independently
+  #pragma omp parallel for num_threads(n_threads) schedule(dynamic, 1) private(i, j, k)
+  for(int b = 0; b < blocks; b++) {
+
+    // Block members
+    int q = size[order[b]];
+    const int* block = &members[start[order[b]]];
+    size_t block_elements = (size_t) q * q;
+
+    // Initialize packed memory
+    double* S_block = (double*) malloc(4 * block_elements * sizeof(double));
+    double* rho_block = S_block + block_elements;
+    double* W_block = rho_block + block_elements;
+    double* B_block = W_block + block_elements;
+    double* K_block = (double*) malloc(block_elements * sizeof(double));
+    double* z = (double*) malloc(q * sizeof(double));
+
+    // Pack
+    for(j = 0; j < q; j++) {
+      for(i = 0; i < q; i++) {
+        size_t full = block[i] + (size_t) block[j] * p;
+        size_t packed = i + (size_t) j * q;
+        S_block[packed] = S[full];
+        rho_block[packed] = rho[full];
+        W_block[packed] = W[full];
+        B_block[packed] = B[full];
+      }
+    }
+
+    // Solve block
+    glasso_block(
+      S_block, rho_block, q, shrink, threshold, maxit,
+      W_block, B_block, K_block, z
+    );
+
+    // Unpack (blocks do not overlap)
+    for(j = 0; j < q; j++) {
+      for(i = 0; i < q; i++) {
+        size_t full = block[i] + (size_t) block[j] * p;
+        size_t packed = i + (size_t) j * q;
+        W[full] = W_block[packed];
+        B[full] = B_block[packed];
+        K[full] = K_block[packed];
+      }
+    }
+
+    // Free memory
+    free(S_block);
+    free(K_block);
+    free(z);
+
+  }
+
+  // Free memory
+  free(parent);
+  free(component);
+  free(label);
+  free(size);
+  free(start);
+  free(members);
+  free(fill);
+  free(order);
+
+}
+
+// Log-determinant from Cholesky factor (NaN if not positive definite)
+static double cholesky_log_determinant(const double* A, int p, double* L) {
+
+  // Initialize iterators
+  int i, j, k;
+
+  // Initialize log-determinant
+  double log_determinant = 0.0;
+
+  // Column-wise Cholesky (lower triangle)
+  for(j = 0; j < p; j++) {
+
+    // Diagonal
+    double value = A[j + (size_t) j * p];
+    for(k = 0; k < j; k++) {
+      value -= L[j + (size_t) k * p] * L[j + (size_t) k * p];
+    }
+
+    // Check for positive definite
+    if(!(value > 0.0)) {
+      return NAN;
+    }
+
+    // Set diagonal
+    double diagonal = sqrt(value);
+    L[j + (size_t) j * p] = diagonal;
+    log_determinant += 2.0 * log(diagonal);
+
+    // Below diagonal
+    for(i = j + 1; i < p; i++) {
+      value = A[i + (size_t) j * p];
+      for(k = 0; k < j; k++) {
+        value -= L[i + (size_t) k * p] * L[j + (size_t) k * p];
+      }
+      L[i + (size_t) j * p] = value / diagonal;
+    }
+
+  }
+
+  // Return log-determinant
+  return log_determinant;
+
+}
+
+// Graphical lasso path with EBIC selection
+// `lambda` is ascending (as in `EBICglasso.qgraph`) and `penalty` may be NULL
+// Returns the zero-indexed optimal lambda or -1 when no lambda has a
+// finite EBIC (`optimal` is then zero)
+int glasso_path(
+    const double* S, int p, const double* lambda, int nlambda,
+    const double* penalty, int penalize_diagonal,
+    double n, double gamma, int count_diagonal,
+    double thr, int maxit, int n_threads,
+    double* ebic, double* loglik, double* optimal
+) {
+
+  // Initialize iterators
+  int i, l;
+  size_t elements = (size_t) p * p;
+
+  // Initialize memory
+  double* W = (double*) malloc(elements * sizeof(double));
+  double* B = (double*) calloc(elements, sizeof(double));
+  double* K = (double*) malloc(elements * sizeof(double));
+  double* L = (double*) malloc(elements * sizeof(double));
+  double* rho = (double*) malloc(elements * sizeof(double));
+
+  // Initialize covariance (cold start at largest lambda)
+  memcpy(W, S, elements * sizeof(double));
+
+  // EBIC constants
+  double half_n = n / 2;
+  double edge_penalty = log(n) + 4 * gamma * log((double) p);
+
+  // Initialize optimal
+  int best = -1;
+  double best_ebic = INFINITY;
+  memset(optimal, 0, elements * sizeof(double));
+
+  // Loop over lambdas (largest to smallest)
+  for(l = nlambda - 1; l >= 0; l--) {
+
+    // Set penalty matrix
+    for(i = 0; i < (int) elements; i++) {
+      rho[i] = (penalty == NULL ? 1.0 : penalty[i]) * lambda[l];
+    }
+
+    // Solve glasso (warm start)
+    glasso_solve(S, rho, p, penalize_diagonal, thr, maxit, n_threads, W, B, K);
+
+    // Log-determinant
+    double log_determinant = cholesky_log_determinant(K, p, L);
+
+    // Trace of `S %*% K` and non-zero count
+    double trace = 0.0;
+    int non_zero = 0;
+    for(i = 0; i < (int) elements; i++) {
+      trace += S[i] * K[i];
+      non_zero += (K[i] != 0.0);
+    }
+
+    // Log-likelihood
+    loglik[l] = half_n * (log_determinant - trace);
+
+    // Edges (same as `edge_count`)
+    double edges = (non_zero - (count_diagonal ? p : 0)) * 0.50;
+
+    // EBIC
+    ebic[l] = -2 * loglik[l] + edges * edge_penalty;
+
+    // Keep best (ties go to the smaller lambda like `which.min`)
+    if(R_FINITE(ebic[l]) && ebic[l] <= best_ebic) {
+      best_ebic = ebic[l];
+      best = l;
+      memcpy(optimal, K, elements * sizeof(double));
+    }
+
+  }
+
+  // Free memory
+  free(W);
+  free(B);
+  free(K);
+  free(L);
+  free(rho);
+
+  // Return optimal
+  return best;
+
+}
+
+// Interface with R
+SEXP r_glasso_path(
+    SEXP r_S, SEXP r_lambda, SEXP r_penalty,
+    SEXP r_penalize_diagonal, SEXP r_n, SEXP r_gamma,
+    SEXP r_count_diagonal, SEXP r_thr, SEXP r_maxit,
+    SEXP r_ncores
+) {
+
+  // Get dimensions
+  int p = ncols(r_S);
+  int nlambda = length(r_lambda);
+
+  // Initialize R results
+  SEXP r_ebic = PROTECT(allocVector(REALSXP, nlambda));
+  SEXP r_loglik = PROTECT(allocVector(REALSXP, nlambda));
+  SEXP r_optimal = PROTECT(allocMatrix(REALSXP, p, p));
+  SEXP r_index = PROTECT(allocVector(INTSXP, 1));
+
+  // Call the C function
+  int best = glasso_path(
+    REAL(r_S), p, REAL(r_lambda), nlambda,
+    isNull(r_penalty) ? NULL : REAL(r_penalty),
+    LOGICAL(r_penalize_diagonal)[0],
+    REAL(r_n)[0], REAL(r_gamma)[0],
+    LOGICAL(r_count_diagonal)[0],
+    REAL(r_thr)[0], INTEGER(r_maxit)[0], INTEGER(r_ncores)[0],
+    REAL(r_ebic), REAL(r_loglik), REAL(r_optimal)
+  );
+
+  // Set optimal index (1-based for R)
+  INTEGER(r_index)[0] = (best < 0) ? NA_INTEGER : best + 1;
+
+  // Set up result list
+  SEXP r_result = PROTECT(allocVector(VECSXP, 4));
+  SET_VECTOR_ELT(r_result, 0, r_optimal);
+  SET_VECTOR_ELT(r_result, 1, r_index);
+  SET_VECTOR_ELT(r_result, 2, r_ebic);
+  SET_VECTOR_ELT(r_result, 3, r_loglik);
+
+  // Set names
+  SEXP r_names = PROTECT(allocVector(STRSXP, 4));
+  SET_STRING_ELT(r_names, 0, mkChar("wi"));
+  SET_STRING_ELT(r_names, 1, mkChar("opt"));
+  SET_STRING_ELT(r_names, 2, mkChar("ebic"));
+  SET_STRING_ELT(r_names, 3, mkChar("loglik"));
+  setAttrib(r_result, R_NamesSymbol, r_names);
+
+  // Release protected SEXP objects
+  UNPROTECT(6);
+
+  // Return result
+  return r_result;
+
+}
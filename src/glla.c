@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Generalized local linear approximation (GLLA) derivatives
+
+ Same as `Embed(x, n.embed, tau) %*% L` for every variable of every
+ individual, without building the embedding matrices: row r of the
+ embedding is x[r], x[r + tau], ..., x[r + (n.embed - 1) * tau], so
+ each derivative is a sliding-window sum of the series weighted by
+ a column of L
+
+ Data are the stacked time series of all individuals (rows ordered by
+ individual); output is one long matrix with columns ordered by
+ variable and then derivative (e.g., V1.Ord0, V1.Ord1, V1.Ord2, V2.Ord0)
+
+*/
+
+// Derivatives of one individual
+static void individual_glla(
+    const double* data, int n, int p, int start, int length,
+    const double* L, int n_embed, int orders, int tau,
+    double* output, int n_output, int output_start
+) {
+
+  // Number of embedded rows
+  int rows = length - (n_embed - 1) * tau;
+
+  // Loop over variables
+  for(int v = 0; v < p; v++) {
+
+    // Time series of individual
+    const double* series = &data[start + (size_t) v * n];
+
+    // Loop over derivatives
+    for(int d = 0; d < orders; d++) {
+
+      // Weights and output column
+      const double* weights = &L[(size_t) d * n_embed];
+      double* column = &output[output_start + (size_t) (v * orders + d) * n_output];
+
+      // Sliding window
+      for(int r = 0; r < rows; r++) {
+        double sum = 0.0;
+        for(int i = 0; i < n_embed; i++) {
+          sum += series[r + i * tau] * weights[i];
+        }
+        column[r] = sum;
+      }
+
+    }
+
+  }
+
+}
+
+// Interface with R
+// `r_lengths` are the number of time points of each individual
+SEXP r_glla_derivatives(
+    SEXP r_data, SEXP r_lengths, SEXP r_weights, SEXP r_tau, SEXP r_ncores
+) {
+
+  // Get dimensions
+  int n = nrows(r_data);
+  int p = ncols(r_data);
+  int n_embed = nrows(r_weights);
+  int orders = ncols(r_weights);
+  int tau = INTEGER(r_tau)[0];
+  int individuals = length(r_lengths);
+  int* lengths = INTEGER(r_lengths);
+
+  // Input and output starts of each individual
+  int* starts = (int*) R_alloc(individuals, sizeof(int));
+  int* output_starts = (int*) R_alloc(individuals, sizeof(int));
+  int input_total = 0, output_total = 0;
+  for(int k = 0; k < individuals; k++) {
+    starts[k] = input_total;
+    output_starts[k] = output_total;
+    input_total += lengths[k];
+    int rows = lengths[k] - (n_embed - 1) * tau;
+    output_total += (rows > 0) ? rows : 0;
+  }
+
+  // Check lengths
+  if(input_total != n) {
+    Rf_error("Time series lengths must add up to the number of rows in the data. Terminating...");
+  }
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocMatrix(REALSXP, output_total, p * orders));
+
+  // Get pointers
+  const double* data = REAL(r_data);
+  const double* L = REAL(r_weights);
+  double* output = REAL(r_output);
+
+  // Loop over individuals
+  #pragma omp parallel for schedule(dynamic) num_threads(INTEGER(r_ncores)[0])
+  for(int k = 0; k < individuals; k++) {
+    individual_glla(
+      data, n, p, starts[k], lengths[k], L, n_embed, orders, tau,
+      output, output_total, output_starts[k]
+    );
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
@@ -10,6 +10,34 @@ extern SEXP r_xoshiro_seeds(SEXP n, SEXP r_seed);
 extern SEXP r_xoshiro_uniform(SEXP n, SEXP r_seed);
 extern SEXP r_xoshiro_shuffle(SEXP r_vector, SEXP r_seed);
 extern SEXP r_xoshiro_shuffle_replace(SEXP r_vector, SEXP r_seed);
+extern SEXP r_ordinal_copula(SEXP r_cases, SEXP r_factor, SEXP r_thresholds, SEXP r_seed);
+extern SEXP r_consensus_matrix(SEXP r_memberships, SEXP r_threshold, SEXP r_ncores);
+extern SEXP r_membership_table(SEXP r_memberships);
+extern SEXP r_tmfg(SEXP r_correlation, SEXP r_first_four);
+extern SEXP r_tmfg_logo(SEXP r_correlation, SEXP r_cliques, SEXP r_separators);
+extern SEXP r_glasso_path(SEXP r_S, SEXP r_lambda, SEXP r_penalty, SEXP r_penalize_diagonal, SEXP r_n, SEXP r_gamma, SEXP r_count_diagonal, SEXP r_thr, SEXP r_maxit, SEXP r_ncores);
+extern SEXP r_spectral_entropy(SEXP r_matrix, SEXP r_base, SEXP r_tolerance, SEXP r_seed);
+extern SEXP r_tefi_batch(SEXP r_correlation, SEXP r_lower, SEXP r_higher, SEXP r_ncores);
+extern SEXP r_permutation_pooled(SEXP r_data);
+extern SEXP r_permutation_correlation(SEXP r_data, SEXP r_pooled, SEXP r_index, SEXP r_empty_method, SEXP r_empty_value);
+extern SEXP r_accumulate_permutations(SEXP r_state, SEXP r_values);
+extern SEXP r_network_pack(SEXP r_network);
+extern SEXP r_network_unpack(SEXP r_store, SEXP r_offset, SEXP r_p);
+extern SEXP r_network_summary(SEXP r_store, SEXP r_p, SEXP r_statistic, SEXP r_ncores);
+extern SEXP r_get_time_ns(void);
+extern SEXP r_wto(SEXP r_network, SEXP r_signed, SEXP r_diagonal_zero);
+extern SEXP r_wto_tracker(SEXP r_signed);
+extern SEXP r_wto_tracker_update(SEXP r_pointer, SEXP r_remove, SEXP r_slots, SEXP r_network);
+extern SEXP r_wto_tracker_matrix(SEXP r_pointer, SEXP r_slots, SEXP r_diagonal_zero);
+extern SEXP r_glla_derivatives(SEXP r_data, SEXP r_lengths, SEXP r_weights, SEXP r_tau, SEXP r_ncores);
+extern SEXP r_edge_signatures(SEXP r_values);
+extern SEXP r_edge_complexity(SEXP r_edges, SEXP r_shuffles, SEXP r_seed, SEXP r_ncores);
+extern SEXP r_homogenize_memberships(SEXP r_target, SEXP r_memberships, SEXP r_ncores);
+extern SEXP r_pairwise_correlation(SEXP r_data, SEXP r_spearman, SEXP r_ncores);
+extern SEXP r_cholesky_check(SEXP r_matrix);
+extern SEXP r_nearest_pd(SEXP r_matrix, SEXP r_higham, SEXP r_tolerance, SEXP r_max_iterations);
+extern SEXP r_data_hash(SEXP r_object, SEXP r_seed);
+extern SEXP r_resolution_path(SEXP r_network, SEXP r_resolution, SEXP r_cpm, SEXP r_ncores);
 
 // Register native routine
 static const R_CallMethodDef CallEntries[] = {
@@ -49,6 +77,146 @@ static const R_CallMethodDef CallEntries[] = {
         (DL_FUNC)&r_xoshiro_shuffle_replace, // Name of C function
          2 // Number of arguments
     },
+    {
+        "r_ordinal_copula", // Name of function call in R
+        (DL_FUNC)&r_ordinal_copula, // Name of C function
+         4 // Number of arguments
+    },
+    {
+        "r_consensus_matrix", // Name of function call in R
+        (DL_FUNC)&r_consensus_matrix, // Name of C function
+         3 // Number of arguments
+    },
+    {
+        "r_membership_table", // Name of function call in R
+        (DL_FUNC)&r_membership_table, // Name of C function
+         1 // Number of arguments
+    },
+    {
+        "r_tmfg", // Name of function call in R
+        (DL_FUNC)&r_tmfg, // Name of C function
+         2 // Number of arguments
+    },
+    {
+        "r_tmfg_logo", // Name of function call in R
+        (DL_FUNC)&r_tmfg_logo, // Name of C function
+         3 // Number of arguments
+    },
+    {
+        "r_glasso_path", // Name of function call in R
+        (DL_FUNC)&r_glasso_path, // Name of C function
+         10 // Number of arguments
+    },
+    {
+        "r_spectral_entropy", // Name of function call in R
+        (DL_FUNC)&r_spectral_entropy, // Name of C function
+         4 // Number of arguments
+    },
+    {
+        "r_tefi_batch", // Name of function call in R
+        (DL_FUNC)&r_tefi_batch, // Name of C function
+         4 // Number of arguments
+    },
+    {
+        "r_permutation_pooled", // Name of function call in R
+        (DL_FUNC)&r_permutation_pooled, // Name of C function
+         1 // Number of arguments
+    },
+    {
+        "r_permutation_correlation", // Name of function call in R
+        (DL_FUNC)&r_permutation_correlation, // Name of C function
+         5 // Number of arguments
+    },
+    {
+        "r_accumulate_permutations", // Name of function call in R
+        (DL_FUNC)&r_accumulate_permutations, // Name of C function
+         2 // Number of arguments
+    },
+    {
+        "r_network_pack", // Name of function call in R
+        (DL_FUNC)&r_network_pack, // Name of C function
+         1 // Number of arguments
+    },
+    {
+        "r_network_unpack", // Name of function call in R
+        (DL_FUNC)&r_network_unpack, // Name of C function
+         3 // Number of arguments
+    },
+    {
+        "r_network_summary", // Name of function call in R
+        (DL_FUNC)&r_network_summary, // Name of C function
+         4 // Number of arguments
+    },
+    {
+        "r_get_time_ns", // Name of function call in R
+        (DL_FUNC)&r_get_time_ns, // Name of C function
+         0 // Number of arguments
+    },
+    {
+        "r_wto", // Name of function call in R
+        (DL_FUNC)&r_wto, // Name of C function
+         3 // Number of arguments
+    },
+    {
+        "r_wto_tracker", // Name of function call in R
+        (DL_FUNC)&r_wto_tracker, // Name of C function
+         1 // Number of arguments
+    },
+    {
+        "r_wto_tracker_update", // Name of function call in R
+        (DL_FUNC)&r_wto_tracker_update, // Name of C function
+         4 // Number of arguments
+    },
+    {
+        "r_wto_tracker_matrix", // Name of function call in R
+        (DL_FUNC)&r_wto_tracker_matrix, // Name of C function
+         3 // Number of arguments
+    },
+    {
+        "r_glla_derivatives", // Name of function call in R
+        (DL_FUNC)&r_glla_derivatives, // Name of C function
+         5 // Number of arguments
+    },
+    {
+        "r_edge_signatures", // Name of function call in R
+        (DL_FUNC)&r_edge_signatures, // Name of C function
+         1 // Number of arguments
+    },
+    {
+        "r_edge_complexity", // Name of function call in R
+        (DL_FUNC)&r_edge_complexity, // Name of C function
+         4 // Number of arguments
+    },
+    {
+        "r_homogenize_memberships", // Name of function call in R
+        (DL_FUNC)&r_homogenize_memberships, // Name of C function
+         3 // Number of arguments
+    },
+    {
+        "r_pairwise_correlation", // Name of function call in R
+        (DL_FUNC)&r_pairwise_correlation, // Name of C function
+         3 // Number of arguments
+    },
+    {
+        "r_cholesky_check", // Name of function call in R
+        (DL_FUNC)&r_cholesky_check, // Name of C function
+         1 // Number of arguments
+    },
+    {
+        "r_nearest_pd", // Name of function call in R
+        (DL_FUNC)&r_nearest_pd, // Name of C function
+         4 // Number of arguments
+    },
+    {
+        "r_data_hash", // Name of function call in R
+        (DL_FUNC)&r_data_hash, // Name of C function
+         2 // Number of arguments
+    },
+    {
+        "r_resolution_path", // Name of function call in R
+        (DL_FUNC)&r_resolution_path, // Name of C function
+         4 // Number of arguments
+    },
     {NULL, NULL, 0}
 
 };
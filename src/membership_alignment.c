@@ -0,0 +1,323 @@
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Membership alignment (homogenization)
+
+ Each membership vector (row) is relabeled to best match a target
+ membership: the contingency table between its communities and the
+ target's communities is built in O(p) and the labels are matched
+ optimally with the Hungarian algorithm (maximum total overlap on
+ the square k x k table). Communities without a match (more
+ communities than the target) receive new labels after the largest
+ target label, larger communities first
+
+ Only variables with non-missing memberships in both are aligned;
+ other variables keep their original values
+
+*/
+
+// Hungarian algorithm (minimum cost assignment, square n x n)
+// `cost` is row-major; `assignment[i]` is the column of row i
+static void hungarian(const double* cost, int n, int* assignment, double* work, int* iwork) {
+
+  // Initialize memory (1-based potentials)
+  double* u = work;
+  double* v = &work[n + 1];
+  double* minimum = &work[2 * (n + 1)];
+  int* p = iwork;
+  int* way = &iwork[n + 1];
+  char* used = (char*) &iwork[2 * (n + 1)];
+
+  // Initialize potentials and matches
+  for(int j = 0; j <= n; j++) {
+    u[j] = v[j] = 0.0;
+    p[j] = way[j] = 0;
+  }
+
+  // Add rows one at a time
+  for(int i = 1; i <= n; i++) {
+
+    // Start at dummy column
+    p[0] = i;
+    int j0 = 0;
+    for(int j = 0; j <= n; j++) {
+      minimum[j] = R_PosInf;
+      used[j] = 0;
+    }
+
+    // Find augmenting path
+    do {
+
+      // Mark column
+      used[j0] = 1;
+      int i0 = p[j0], j1 = 0;
+      double delta = R_PosInf;
+
+      // Update reduced costs
+      for(int j = 1; j <= n; j++) {
+        if(!used[j]) {
+          double current = cost[(size_t) (i0 - 1) * n + (j - 1)] - u[i0] - v[j];
+          if(current < minimum[j]) {
+            minimum[j] = current;
+            way[j] = j0;
+          }
+          if(minimum[j] < delta) {
+            delta = minimum[j];
+            j1 = j;
+          }
+        }
+      }
+
+      // Update potentials
+      for(int j = 0; j <= n; j++) {
+        if(used[j]) {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        }else{
+          minimum[j] -= delta;
+        }
+      }
+
+      // Move to next column
+      j0 = j1;
+
+    } while(p[j0] != 0);
+
+    // Augment along path
+    do {
+      int j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    } while(j0);
+
+  }
+
+  // Set assignment
+  for(int j = 1; j <= n; j++) {
+    if(p[j] != 0) {
+      assignment[p[j] - 1] = j - 1;
+    }
+  }
+
+}
+
+// Align one membership vector
+// `target_index` are 0-based target communities (-1 for missing)
+static void align_membership(
+    const int* target_index, const int* target_labels, int k_target,
+    int maximum_label, const int* membership, int stride, int p,
+    int* output, int* labels, int* table, int* sizes,
+    double* cost, int* assignment, int* order, double* work, int* iwork
+) {
+
+  // Initialize communities
+  int k_convert = 0;
+
+  // Re-index communities (order of first appearance) and count overlap
+  for(int j = 0; j < p; j++) {
+
+    // Copy original value
+    int value = membership[(size_t) j * stride];
+    output[(size_t) j * stride] = value;
+
+    // Skip missing
+    if(value == NA_INTEGER || target_index[j] == -1) {
+      continue;
+    }
+
+    // Find community
+    int c;
+    for(c = 0; c < k_convert; c++) {
+      if(labels[c] == value) {
+        break;
+      }
+    }
+
+    // Add community
+    if(c == k_convert) {
+      labels[k_convert] = value;
+      sizes[k_convert] = 0;
+      memset(&table[(size_t) k_convert * k_target], 0, k_target * sizeof(int));
+      k_convert++;
+    }
+
+    // Count overlap
+    sizes[c]++;
+    table[(size_t) c * k_target + target_index[j]]++;
+
+  }
+
+  // Check for communities
+  if(k_convert == 0) {
+    return;
+  }
+
+  // Square cost (negative overlap; padded with zeros)
+  int n = (k_convert > k_target) ? k_convert : k_target;
+  for(int c = 0; c < n; c++) {
+    for(int t = 0; t < n; t++) {
+      cost[(size_t) c * n + t] = (c < k_convert && t < k_target) ?
+        -(double) table[(size_t) c * k_target + t] : 0.0;
+    }
+  }
+
+  // Optimal matching
+  hungarian(cost, n, assignment, work, iwork);
+
+  // Unmatched communities (larger first, then first appearance)
+  int unmatched = 0;
+  for(int c = 0; c < k_convert; c++) {
+    if(assignment[c] >= k_target) {
+      int position = unmatched++;
+      while(position > 0 && sizes[order[position - 1]] < sizes[c]) {
+        order[position] = order[position - 1];
+        position--;
+      }
+      order[position] = c;
+    }
+  }
+
+  // New labels (re-use `sizes` as labels)
+  for(int c = 0; c < k_convert; c++) {
+    if(assignment[c] < k_target) {
+      sizes[c] = target_labels[assignment[c]];
+    }
+  }
+  for(int u = 0; u < unmatched; u++) {
+    sizes[order[u]] = maximum_label + u + 1;
+  }
+
+  // Replace values
+  for(int j = 0; j < p; j++) {
+
+    // Skip missing
+    int value = membership[(size_t) j * stride];
+    if(value == NA_INTEGER || target_index[j] == -1) {
+      continue;
+    }
+
+    // Find community
+    for(int c = 0; c < k_convert; c++) {
+      if(labels[c] == value) {
+        output[(size_t) j * stride] = sizes[c];
+        break;
+      }
+    }
+
+  }
+
+}
+
+// Interface with R
+// `r_memberships` are iterations x variables
+SEXP r_homogenize_memberships(SEXP r_target, SEXP r_memberships, SEXP r_ncores) {
+
+  // Get dimensions
+  int iterations = nrows(r_memberships);
+  int p = ncols(r_memberships);
+  int n_threads = INTEGER(r_ncores)[0];
+  const int* target = INTEGER(r_target);
+
+  // Check dimensions
+  if(length(r_target) != p) {
+    Rf_error("Target membership must have the same length as the memberships. Terminating...");
+  }
+
+  // Target communities (sorted labels)
+  int* target_labels = (int*) R_alloc(p > 0 ? p : 1, sizeof(int));
+  int* target_index = (int*) R_alloc(p > 0 ? p : 1, sizeof(int));
+  int k_target = 0, maximum_label = 0;
+  for(int j = 0; j < p; j++) {
+
+    // Skip missing
+    if(target[j] == NA_INTEGER) {
+      continue;
+    }
+
+    // Insert label (sorted, unique)
+    int position = 0;
+    while(position < k_target && target_labels[position] < target[j]) {
+      position++;
+    }
+    if(position == k_target || target_labels[position] != target[j]) {
+      memmove(
+        &target_labels[position + 1], &target_labels[position],
+        (k_target - position) * sizeof(int)
+      );
+      target_labels[position] = target[j];
+      k_target++;
+    }
+
+    // Update maximum
+    if(target[j] > maximum_label) {
+      maximum_label = target[j];
+    }
+
+  }
+
+  // Target index of each variable
+  for(int j = 0; j < p; j++) {
+    target_index[j] = -1;
+    if(target[j] != NA_INTEGER) {
+      for(int t = 0; t < k_target; t++) {
+        if(target_labels[t] == target[j]) {
+          target_index[j] = t;
+          break;
+        }
+      }
+    }
+  }
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocMatrix(INTSXP, iterations, p));
+
+  // Get pointers
+  const int* memberships = INTEGER(r_memberships);
+  int* output = INTEGER(r_output);
+
+  #pragma omp parallel num_threads(n_threads)
+  {
+
+    // Per thread memory (at most p communities)
+    int n = (p > k_target) ? p : k_target;
+    int* labels = (int*) malloc((n + 1) * sizeof(int));
+    int* sizes = (int*) malloc((n + 1) * sizeof(int));
+    int* order = (int*) malloc((n + 1) * sizeof(int));
+    int* assignment = (int*) malloc((n + 1) * sizeof(int));
+    int* table = (int*) malloc(((size_t) n * (k_target > 0 ? k_target : 1)) * sizeof(int));
+    double* cost = (double*) malloc((size_t) n * n * sizeof(double));
+    double* work = (double*) malloc(3 * (n + 1) * sizeof(double));
+    int* iwork = (int*) malloc((3 * (n + 1)) * sizeof(int));
+
+    #pragma omp for schedule(dynamic, 64)
+    for(int i = 0; i < iterations; i++) {
+      align_membership(
+        target_index, target_labels, k_target, maximum_label,
+        &memberships[i], iterations, p, &output[i],
+        labels, table, sizes, cost, assignment, order, work, iwork
+      );
+    }
+
+    // Free memory
+    free(labels);
+    free(sizes);
+    free(order);
+    free(assignment);
+    free(table);
+    free(cost);
+    free(work);
+    free(iwork);
+
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
@@ -0,0 +1,229 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Canonical membership table
+
+ Each membership vector (row) is relabeled into first-occurrence
+ canonical form (the first community seen is 1, the second is 2, ...)
+ so that equivalent partitions with permuted community labels are
+ identical. Canonical rows are then hashed and counted in one pass
+ (O(iterations * variables))
+
+ Missing memberships (`NA`) are kept as `NA` in the canonical form
+
+*/
+
+// FNV-1a (64-bit) over integers
+static inline uint64_t hash_membership(const int* membership, int cols) {
+
+  // Initialize hash
+  uint64_t hash = 0xcbf29ce484222325ULL;
+
+  // Loop over values
+  for(int j = 0; j < cols; j++) {
+    hash ^= (uint32_t) membership[j];
+    hash *= 0x100000001b3ULL;
+  }
+
+  // Return hash
+  return hash;
+
+}
+
+// Obtain canonical memberships and their table
+int membership_table(
+    int* memberships, int iterations, int cols,
+    int* canonical, int* unique_index, int* counts, int* first
+) {
+
+  // Initialize iterators
+  int i, j, t;
+
+  // Get range of labels
+  int minimum = INT32_MAX, maximum = INT32_MIN;
+  for(i = 0; i < iterations * cols; i++) {
+    if(memberships[i] != NA_INTEGER) {
+      if(memberships[i] < minimum) minimum = memberships[i];
+      if(memberships[i] > maximum) maximum = memberships[i];
+    }
+  }
+
+  // Initialize label map (zero = not yet seen)
+  size_t labels = (minimum <= maximum) ? (size_t) ((int64_t) maximum - minimum + 1) : 1;
+  int* label_map = (int*) calloc(labels, sizeof(int));
+  int* seen = (int*) malloc(cols * sizeof(int));
+
+  // Initialize hash table (power of two at least twice iterations)
+  size_t table_size = 16;
+  while(table_size < (size_t) iterations * 2) {
+    table_size <<= 1;
+  }
+  int* table = (int*) malloc(table_size * sizeof(int));
+  for(size_t k = 0; k < table_size; k++) {
+    table[k] = -1;
+  }
+
+  // Initialize number of unique partitions
+  int n_unique = 0;
+
+  // Loop over iterations
+  for(t = 0; t < iterations; t++) {
+
+    // Canonical row (row-major for hashing and comparisons)
+    int* row = &canonical[(size_t) t * cols];
+
+    // Initialize labels
+    int next_label = 0;
+
+    // Relabel by first occurrence
+    for(j = 0; j < cols; j++) {
+
+      // Get label
+      int label = memberships[t + (size_t) j * iterations];
+
+      // Check for missing
+      if(label == NA_INTEGER) {
+        row[j] = NA_INTEGER;
+        continue;
+      }
+
+      // Get map index
+      int index = label - minimum;
+
+      // Check for new label
+      if(label_map[index] == 0) {
+        label_map[index] = ++next_label;
+        seen[next_label - 1] = index;
+      }
+
+      // Set canonical label
+      row[j] = label_map[index];
+
+    }
+
+    // Reset label map
+    for(i = 0; i < next_label; i++) {
+      label_map[seen[i]] = 0;
+    }
+
+    // Find slot in hash table (linear probing)
+    size_t slot = hash_membership(row, cols) & (table_size - 1);
+
+    while(table[slot] != -1) {
+
+      // Check for same partition
+      if(
+        !memcmp(
+          &canonical[(size_t) first[table[slot]] * cols],
+          row, cols * sizeof(int)
+        )
+      ) {
+        break;
+      }
+
+      // Move to next slot
+      slot = (slot + 1) & (table_size - 1);
+
+    }
+
+    // Check for new partition
+    if(table[slot] == -1) {
+      table[slot] = n_unique;
+      first[n_unique] = t;
+      counts[n_unique] = 0;
+      n_unique++;
+    }
+
+    // Update table
+    counts[table[slot]]++;
+    unique_index[t] = table[slot];
+
+  }
+
+  // Free memory
+  free(label_map);
+  free(seen);
+  free(table);
+
+  // Return number of unique partitions
+  return n_unique;
+
+}
+
+// Interface with R
+SEXP r_membership_table(SEXP r_memberships) {
+
+  // Get dimensions
+  int iterations = nrows(r_memberships);
+  int cols = ncols(r_memberships);
+
+  // Initialize memory
+  int* canonical = (int*) R_alloc((size_t) iterations * cols, sizeof(int));
+  int* unique_index = (int*) R_alloc(iterations, sizeof(int));
+  int* counts = (int*) R_alloc(iterations, sizeof(int));
+  int* first = (int*) R_alloc(iterations, sizeof(int));
+
+  // Call the C function
+  int n_unique = membership_table(
+    INTEGER(r_memberships), iterations, cols,
+    canonical, unique_index, counts, first
+  );
+
+  // Initialize R results
+  SEXP r_unique = PROTECT(allocMatrix(INTSXP, n_unique, cols));
+  SEXP r_counts = PROTECT(allocVector(INTSXP, n_unique));
+  SEXP r_first = PROTECT(allocVector(INTSXP, n_unique));
+  SEXP r_index = PROTECT(allocVector(INTSXP, iterations));
+
+  // Get pointers
+  int* c_unique = INTEGER(r_unique);
+  int* c_counts = INTEGER(r_counts);
+  int* c_first = INTEGER(r_first);
+  int* c_index = INTEGER(r_index);
+
+  // Fill unique partitions (1-based indices for R)
+  for(int k = 0; k < n_unique; k++) {
+
+    // Counts and first occurrence
+    c_counts[k] = counts[k];
+    c_first[k] = first[k] + 1;
+
+    // Canonical partition
+    for(int j = 0; j < cols; j++) {
+      c_unique[k + (size_t) j * n_unique] = canonical[(size_t) first[k] * cols + j];
+    }
+
+  }
+
+  // Fill partition index for each iteration
+  for(int t = 0; t < iterations; t++) {
+    c_index[t] = unique_index[t] + 1;
+  }
+
+  // Set up result list
+  SEXP r_result = PROTECT(allocVector(VECSXP, 4));
+  SET_VECTOR_ELT(r_result, 0, r_unique);
+  SET_VECTOR_ELT(r_result, 1, r_counts);
+  SET_VECTOR_ELT(r_result, 2, r_first);
+  SET_VECTOR_ELT(r_result, 3, r_index);
+
+  // Set names
+  SEXP r_names = PROTECT(allocVector(STRSXP, 4));
+  SET_STRING_ELT(r_names, 0, mkChar("unique"));
+  SET_STRING_ELT(r_names, 1, mkChar("counts"));
+  SET_STRING_ELT(r_names, 2, mkChar("first"));
+  SET_STRING_ELT(r_names, 3, mkChar("index"));
+  setAttrib(r_result, R_NamesSymbol, r_names);
+
+  // Release protected SEXP objects
+  UNPROTECT(6);
+
+  // Return result
+  return r_result;
+
+}
@@ -9,3 +9,8 @@ uint64_t get_time_ns(void) {
     clock_gettime(CLOCK_REALTIME, &ts);
     return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
 }
+
+// Interface with R (nanoseconds as double)
+SEXP r_get_time_ns(void) {
+    return ScalarReal((double) get_time_ns());
+}
@@ -0,0 +1,499 @@
+#define USE_FC_LEN_T
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include <R_ext/Lapack.h>
+#ifndef FCONE
+# define FCONE
+#endif
+
+/*
+
+ Nearest positive definite correlation matrix
+
+ Positive definiteness is checked with a Cholesky factorization
+ (`dpotrf`), which is much cheaper than a full eigendecomposition
+
+ Repairs (unit diagonal):
+
+ Clip: one shot; eigenvalues below `tolerance` times the largest
+ eigenvalue are raised to that value
+
+ Higham: alternating projections with Dykstra's correction (same
+ as `Matrix::nearPD(x, corr = TRUE, keepDiag = TRUE)`). The
+ projection onto the positive semi-definite cone only removes the
+ eigenvalues below `eig.tol` times the largest eigenvalue, so each
+ iteration reduces the matrix to tridiagonal form once (`dsytrd`),
+ finds the largest eigenvalue and only that (usually small) part of
+ the spectrum from the tridiagonal matrix (`dstevr`), and
+ back-transforms those eigenvectors (`dormtr`) rather than computing
+ a full eigendecomposition. After convergence, the clip step ensures
+ positive definiteness
+
+*/
+
+// Relative tolerance of the positive semi-definite projection
+#define EIGEN_TOLERANCE 1e-06
+
+// Convergence tolerance of alternating projections
+#define CONVERGENCE_TOLERANCE 1e-07
+
+// Workspace for the eigenproblem
+// (tridiagonal reduction with `dsytrd`, selected eigenpairs of the
+// tridiagonal matrix with `dstevr`, back-transformation with `dormtr`)
+typedef struct {
+  int n;
+  double* a; // Householder vectors of the reduction
+  double* tau;
+  double* diagonal;
+  double* off_diagonal;
+  double* d; // copies (overwritten by LAPACK)
+  double* e;
+  double* values;
+  double* vectors;
+  int* isuppz;
+  double* work;
+  int* iwork;
+  int lwork;
+  int liwork;
+} eigen_workspace;
+
+// Allocate workspace
+static void eigen_allocate(int n, eigen_workspace* W) {
+
+  // Allocate memory
+  W->n = n;
+  W->a = (double*) malloc((size_t) n * n * sizeof(double));
+  W->tau = (double*) malloc(n * sizeof(double));
+  W->diagonal = (double*) malloc(n * sizeof(double));
+  W->off_diagonal = (double*) malloc(n * sizeof(double));
+  W->d = (double*) malloc(n * sizeof(double));
+  W->e = (double*) malloc(n * sizeof(double));
+  W->values = (double*) malloc(n * sizeof(double));
+  W->vectors = (double*) malloc((size_t) n * n * sizeof(double));
+  W->isuppz = (int*) malloc(2 * n * sizeof(int));
+
+  // Workspace queries
+  char uplo = 'L', side = 'L', trans = 'N', jobz = 'V', range = 'A';
+  double vl = 0.0, vu = 0.0, abstol = 0.0, work_size;
+  int il = 0, iu = 0, m = 0, iwork_size, lwork = -1, liwork = -1, info = 0;
+
+  // Reduction
+  F77_CALL(dsytrd)(
+    &uplo, &n, W->a, &n, W->diagonal, W->off_diagonal, W->tau,
+    &work_size, &lwork, &info FCONE
+  );
+  W->lwork = (int) work_size;
+
+  // Back-transformation
+  F77_CALL(dormtr)(
+    &side, &uplo, &trans, &n, &n, W->a, &n, W->tau, W->vectors, &n,
+    &work_size, &lwork, &info FCONE FCONE FCONE
+  );
+  if((int) work_size > W->lwork) {
+    W->lwork = (int) work_size;
+  }
+
+  // Tridiagonal eigenproblem
+  F77_CALL(dstevr)(
+    &jobz, &range, &n, W->d, W->e, &vl, &vu, &il, &iu, &abstol,
+    &m, W->values, W->vectors, &n, W->isuppz, &work_size, &lwork,
+    &iwork_size, &liwork, &info FCONE FCONE
+  );
+  if((int) work_size > W->lwork) {
+    W->lwork = (int) work_size;
+  }
+  W->liwork = iwork_size;
+
+  // Allocate workspace
+  W->work = (double*) malloc(W->lwork * sizeof(double));
+  W->iwork = (int*) malloc(W->liwork * sizeof(int));
+
+}
+
+// Free workspace
+static void eigen_free(eigen_workspace* W) {
+  free(W->a);
+  free(W->tau);
+  free(W->diagonal);
+  free(W->off_diagonal);
+  free(W->d);
+  free(W->e);
+  free(W->values);
+  free(W->vectors);
+  free(W->isuppz);
+  free(W->work);
+  free(W->iwork);
+}
+
+// Reduce a symmetric matrix to tridiagonal form (once per matrix)
+// Returns 0 on failure
+static int eigen_reduce(const double* matrix, eigen_workspace* W) {
+
+  // Copy matrix
+  int n = W->n;
+  memcpy(W->a, matrix, (size_t) n * n * sizeof(double));
+
+  // Reduce
+  char uplo = 'L';
+  int info = 0;
+  F77_CALL(dsytrd)(
+    &uplo, &n, W->a, &n, W->diagonal, W->off_diagonal, W->tau,
+    W->work, &W->lwork, &info FCONE
+  );
+
+  // Return success
+  return info == 0;
+
+}
+
+// Eigenvalues (and eigenvectors) of the reduced matrix (ascending values)
+// `range` = 'I' for indices `il` to `iu` (1-based) or
+// 'V' for values in (`lower`, `upper`]
+// Returns the number of eigenpairs found (-1 on failure)
+static int eigen_partial(
+    char jobz, char range, int il, int iu,
+    double lower, double upper, eigen_workspace* W
+) {
+
+  // Copy tridiagonal matrix
+  int n = W->n;
+  memcpy(W->d, W->diagonal, n * sizeof(double));
+  memcpy(W->e, W->off_diagonal, n * sizeof(double));
+
+  // Compute eigenpairs of tridiagonal matrix
+  double abstol = 0.0;
+  int m = 0, info = 0;
+  F77_CALL(dstevr)(
+    &jobz, &range, &n, W->d, W->e, &lower, &upper, &il, &iu, &abstol,
+    &m, W->values, W->vectors, &n, W->isuppz, W->work, &W->lwork,
+    W->iwork, &W->liwork, &info FCONE FCONE
+  );
+  if(info != 0) {
+    return -1;
+  }
+
+  // Back-transform eigenvectors
+  if(jobz == 'V' && m > 0) {
+    char side = 'L', uplo = 'L', trans = 'N';
+    F77_CALL(dormtr)(
+      &side, &uplo, &trans, &n, &m, W->a, &n, W->tau, W->vectors, &n,
+      W->work, &W->lwork, &info FCONE FCONE FCONE
+    );
+  }
+
+  // Return number found
+  return (info == 0) ? m : -1;
+
+}
+
+// Largest eigenvalue of the reduced matrix
+static double largest_eigenvalue(eigen_workspace* W) {
+  int m = eigen_partial('N', 'I', W->n, W->n, 0.0, 0.0, W);
+  return (m == 1) ? W->values[0] : NA_REAL;
+}
+
+// Lower bound of the spectrum (Gershgorin)
+static double spectrum_bound(const double* matrix, int n) {
+
+  // Initialize bound
+  double bound = 0.0;
+
+  // Loop over rows
+  for(int i = 0; i < n; i++) {
+    double radius = 0.0;
+    for(int j = 0; j < n; j++) {
+      if(i != j) {
+        radius += fabs(matrix[i + (size_t) j * n]);
+      }
+    }
+    double low = matrix[i + (size_t) i * n] - radius;
+    if(low < bound) {
+      bound = low;
+    }
+  }
+
+  // Return bound (strictly below)
+  return bound - 1.0;
+
+}
+
+// Add `shift[k]` * v_k v_k' for the `m` eigenvectors in workspace
+static void add_eigenpairs(
+    double* matrix, int n, int m, const double* shift, const eigen_workspace* W
+) {
+
+  // Loop over eigenpairs
+  for(int k = 0; k < m; k++) {
+    const double* v = &W->vectors[(size_t) k * n];
+    for(int j = 0; j < n; j++) {
+      double scaled = shift[k] * v[j];
+      double* column = &matrix[(size_t) j * n];
+      for(int i = 0; i < n; i++) {
+        column[i] += v[i] * scaled;
+      }
+    }
+  }
+
+}
+
+// Raise eigenvalues below `tolerance` times the largest and
+// rescale to unit diagonal (returns 0 on failure)
+static int clip_eigenvalues(double* matrix, int n, double tolerance, eigen_workspace* W) {
+
+  // Reduce matrix
+  if(!eigen_reduce(matrix, W)) {
+    return 0;
+  }
+
+  // Get largest eigenvalue
+  double largest = largest_eigenvalue(W);
+  if(ISNAN(largest)) {
+    return 0;
+  }
+  double epsilon = tolerance * fabs(largest);
+
+  // Eigenpairs below epsilon
+  int m = eigen_partial(
+    'V', 'V', 0, 0, spectrum_bound(matrix, n), epsilon, W
+  );
+  if(m < 0) {
+    return 0;
+  }
+
+  // Raise eigenvalues
+  if(m > 0) {
+
+    // Shifts
+    double* shift = (double*) malloc(m * sizeof(double));
+    for(int k = 0; k < m; k++) {
+      shift[k] = epsilon - W->values[k];
+    }
+    add_eigenpairs(matrix, n, m, shift, W);
+    free(shift);
+
+    // Rescale to unit diagonal
+    double* scale = (double*) malloc(n * sizeof(double));
+    for(int i = 0; i < n; i++) {
+      double diagonal = matrix[i + (size_t) i * n];
+      scale[i] = sqrt(((epsilon > 1.0) ? epsilon : 1.0) / diagonal);
+    }
+    for(int j = 0; j < n; j++) {
+      for(int i = 0; i < n; i++) {
+        matrix[i + (size_t) j * n] *= scale[i] * scale[j];
+      }
+    }
+    free(scale);
+
+  }
+
+  // Set diagonal
+  for(int i = 0; i < n; i++) {
+    matrix[i + (size_t) i * n] = 1.0;
+  }
+
+  // Return success
+  return 1;
+
+}
+
+// Infinity norm (maximum absolute row sum)
+static double infinity_norm(const double* matrix, int n) {
+
+  // Initialize norm
+  double norm = 0.0;
+
+  // Loop over rows
+  for(int i = 0; i < n; i++) {
+    double sum = 0.0;
+    for(int j = 0; j < n; j++) {
+      sum += fabs(matrix[i + (size_t) j * n]);
+    }
+    if(sum > norm) {
+      norm = sum;
+    }
+  }
+
+  // Return norm
+  return norm;
+
+}
+
+// Higham's alternating projections (returns iterations or -1 on failure)
+// `converged` is set to 0 when `max_iterations` is reached first
+static int higham_projections(
+    double* matrix, int n, int max_iterations, int* converged, eigen_workspace* W
+) {
+
+  // Initialize memory
+  size_t size = (size_t) n * n;
+  double* correction = (double*) calloc(size, sizeof(double));
+  double* R = (double*) malloc(size * sizeof(double));
+  double* previous = (double*) malloc(size * sizeof(double));
+  double* shift = (double*) malloc(n * sizeof(double));
+
+  // Initialize iterations
+  int iteration = 0, status = 0;
+  double convergence = R_PosInf;
+
+  // Alternating projections
+  while(iteration < max_iterations && convergence > CONVERGENCE_TOLERANCE) {
+
+    // Store previous
+    memcpy(previous, matrix, size * sizeof(double));
+
+    // Dykstra's correction
+    for(size_t k = 0; k < size; k++) {
+      R[k] = matrix[k] - correction[k];
+    }
+
+    // Reduce once for both eigenproblems
+    if(!eigen_reduce(R, W)) {
+      status = -1;
+      break;
+    }
+
+    // Threshold of projection
+    double largest = largest_eigenvalue(W);
+    if(ISNAN(largest) || largest <= 0.0) {
+      status = -1; // negative semi-definite
+      break;
+    }
+
+    // Eigenpairs at or below threshold
+    int m = eigen_partial(
+      'V', 'V', 0, 0, spectrum_bound(R, n), EIGEN_TOLERANCE * largest, W
+    );
+    if(m < 0) {
+      status = -1;
+      break;
+    }
+
+    // Project (remove eigenpairs)
+    memcpy(matrix, R, size * sizeof(double));
+    for(int k = 0; k < m; k++) {
+      shift[k] = -W->values[k];
+    }
+    add_eigenpairs(matrix, n, m, shift, W);
+
+    // Update correction
+    for(size_t k = 0; k < size; k++) {
+      correction[k] = matrix[k] - R[k];
+    }
+
+    // Symmetrize and set unit diagonal
+    for(int j = 0; j < n; j++) {
+      for(int i = j + 1; i < n; i++) {
+        double value = (matrix[i + (size_t) j * n] + matrix[j + (size_t) i * n]) / 2;
+        matrix[i + (size_t) j * n] = matrix[j + (size_t) i * n] = value;
+      }
+      matrix[j + (size_t) j * n] = 1.0;
+    }
+
+    // Convergence
+    double previous_norm = infinity_norm(previous, n);
+    for(size_t k = 0; k < size; k++) {
+      previous[k] -= matrix[k];
+    }
+    convergence = infinity_norm(previous, n) / previous_norm;
+
+    // Increase iteration
+    iteration++;
+
+  }
+
+  // Check for convergence
+  *converged = convergence <= CONVERGENCE_TOLERANCE;
+
+  // Free memory
+  free(correction);
+  free(R);
+  free(previous);
+  free(shift);
+
+  // Return iterations
+  return (status == 0) ? iteration : status;
+
+}
+
+// Interface with R (positive definite check)
+SEXP r_cholesky_check(SEXP r_matrix) {
+
+  // Get dimensions
+  int n = ncols(r_matrix);
+  const double* matrix = REAL(r_matrix);
+
+  // Check for finite values
+  for(size_t k = 0; k < (size_t) n * n; k++) {
+    if(!R_FINITE(matrix[k])) {
+      Rf_error("Matrix contains infinite or missing values. Terminating...");
+    }
+  }
+
+  // Initialize factor
+  double* factor = (double*) R_alloc((size_t) n * n, sizeof(double));
+  memcpy(factor, matrix, (size_t) n * n * sizeof(double));
+
+  // Cholesky factorization
+  char uplo = 'U';
+  int info = 0;
+  F77_CALL(dpotrf)(&uplo, &n, factor, &n, &info FCONE);
+
+  // Return check
+  return ScalarLogical(info == 0);
+
+}
+
+// Interface with R (nearest positive definite correlation matrix)
+SEXP r_nearest_pd(
+    SEXP r_matrix, SEXP r_higham, SEXP r_tolerance, SEXP r_max_iterations
+) {
+
+  // Get dimensions
+  int n = ncols(r_matrix);
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocMatrix(REALSXP, n, n));
+  double* matrix = REAL(r_output);
+  memcpy(matrix, REAL(r_matrix), (size_t) n * n * sizeof(double));
+
+  // Initialize workspace
+  eigen_workspace W;
+  eigen_allocate(n, &W);
+
+  // Alternating projections
+  int status = 0, converged = 1;
+  if(LOGICAL(r_higham)[0]) {
+    status = higham_projections(
+      matrix, n, INTEGER(r_max_iterations)[0], &converged, &W
+    );
+  }
+
+  // Ensure positive definite
+  if(status >= 0 && !clip_eigenvalues(matrix, n, REAL(r_tolerance)[0], &W)) {
+    status = -1;
+  }
+
+  // Free workspace
+  eigen_free(&W);
+
+  // Check for failure
+  if(status < 0) {
+    UNPROTECT(1);
+    Rf_error("Could not find the nearest positive definite matrix (matrix seems negative semi-definite). Terminating...");
+  }
+
+  // Check for convergence (same as `Matrix::nearPD`)
+  if(!converged) {
+    Rf_warning("Nearest positive definite matrix did not converge in %d iterations", status);
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
@@ -0,0 +1,303 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Compact store for bootstrap networks
+
+ Each network is kept as its lower triangle (with diagonal) in
+ single precision (float32), packed into a raw vector. Networks
+ are appended one after the other so that a single network can be
+ unpacked on demand and summaries (median, mean, edge frequency)
+ are computed directly from the packed values without expanding
+ every network
+
+*/
+
+// Statistics for summaries
+#define STORE_MEDIAN 0
+#define STORE_MEAN 1
+#define STORE_FREQUENCY 2
+
+// Elements in block of summaries
+#define STORE_BLOCK 256
+
+// Number of values in lower triangle (with diagonal)
+static inline size_t triangle_length(int p) {
+  return (size_t) p * (p + 1) / 2;
+}
+
+// Pack lower triangle (column-major) into floats
+static void pack_network(const double* network, int p, float* packed) {
+
+  // Initialize index
+  size_t index = 0;
+
+  // Loop over columns
+  for(int j = 0; j < p; j++) {
+    for(int i = j; i < p; i++) {
+      packed[index++] = (float) network[i + (size_t) j * p];
+    }
+  }
+
+}
+
+// Unpack floats into symmetric matrix
+static void unpack_network(const float* packed, int p, double* network) {
+
+  // Initialize index
+  size_t index = 0;
+
+  // Loop over columns
+  for(int j = 0; j < p; j++) {
+    for(int i = j; i < p; i++) {
+      network[i + (size_t) j * p] = network[j + (size_t) i * p] =
+        (double) packed[index++];
+    }
+  }
+
+}
+
+// Select k-th smallest value (values are reordered)
+static float select_value(float* values, int n, int k) {
+
+  // Initialize bounds
+  int left = 0, right = n - 1;
+
+  // Quickselect (Hoare partition)
+  while(left < right) {
+
+    // Pivot
+    float pivot = values[left + (right - left) / 2];
+    int i = left, j = right;
+
+    // Partition
+    while(i <= j) {
+      while(values[i] < pivot) {
+        i++;
+      }
+      while(values[j] > pivot) {
+        j--;
+      }
+      if(i <= j) {
+        float swap = values[i];
+        values[i] = values[j];
+        values[j] = swap;
+        i++;
+        j--;
+      }
+    }
+
+    // Continue in side with k
+    if(k <= j) {
+      right = j;
+    }else if(k >= i) {
+      left = i;
+    }else{
+      break;
+    }
+
+  }
+
+  // Return value
+  return values[k];
+
+}
+
+// Summary of one element across networks (`values` are reordered)
+static double summarize_values(float* values, int n, int statistic) {
+
+  // Initialize iterator
+  int k;
+
+  // Edge frequency (missing values are ignored)
+  if(statistic == STORE_FREQUENCY) {
+
+    // Count non-zero and available
+    int non_zero = 0, available = 0;
+    for(k = 0; k < n; k++) {
+      if(!isnan(values[k])) {
+        available++;
+        non_zero += values[k] != 0.0f;
+      }
+    }
+
+    // Return proportion
+    return (available == 0) ? NA_REAL : (double) non_zero / available;
+
+  }
+
+  // Missing values return `NA` (same as `median` and `mean`)
+  for(k = 0; k < n; k++) {
+    if(isnan(values[k])) {
+      return NA_REAL;
+    }
+  }
+
+  // Mean
+  if(statistic == STORE_MEAN) {
+    long double sum = 0.0L;
+    for(k = 0; k < n; k++) {
+      sum += values[k];
+    }
+    return (double) (sum / n);
+  }
+
+  // Median (average of two middle values for even lengths)
+  int half = n / 2;
+  double upper = (double) select_value(values, n, half);
+  if(n % 2) {
+    return upper;
+  }
+
+  // Lower middle value is the largest value below `half`
+  float lower = values[0];
+  for(k = 1; k < half; k++) {
+    if(values[k] > lower) {
+      lower = values[k];
+    }
+  }
+
+  // Return median
+  return ((double) lower + upper) / 2;
+
+}
+
+// Summarize networks (all with `p` variables)
+static void summarize_networks(
+    const float* store, int networks, int p, int statistic,
+    int n_threads, double* output
+) {
+
+  // Number of values per network
+  size_t length = triangle_length(p);
+  size_t blocks = (length + STORE_BLOCK - 1) / STORE_BLOCK;
+
+  // Summary of lower triangle
+  double* summary = (double*) malloc(length * sizeof(double));
+
+  #pragma omp parallel num_threads(n_threads)
+  {
+
+    // Values of block across networks (per thread)
+    float* block = (float*) malloc((size_t) STORE_BLOCK * networks * sizeof(float));
+    float* values = (float*) malloc(networks * sizeof(float));
+
+    #pragma omp for schedule(dynamic)
+    for(size_t b = 0; b < blocks; b++) {
+
+      // Block bounds
+      size_t start = b * STORE_BLOCK;
+      int size = (int) ((start + STORE_BLOCK <= length) ? STORE_BLOCK : length - start);
+
+      // Copy block of each network (contiguous reads)
+      for(int n = 0; n < networks; n++) {
+        memcpy(
+          &block[(size_t) n * STORE_BLOCK], &store[(size_t) n * length + start],
+          size * sizeof(float)
+        );
+      }
+
+      // Summarize each element
+      for(int e = 0; e < size; e++) {
+        for(int n = 0; n < networks; n++) {
+          values[n] = block[(size_t) n * STORE_BLOCK + e];
+        }
+        summary[start + e] = summarize_values(values, networks, statistic);
+      }
+
+    }
+
+    // Free memory
+    free(block);
+    free(values);
+
+  }
+
+  // Expand to symmetric matrix
+  size_t index = 0;
+  for(int j = 0; j < p; j++) {
+    for(int i = j; i < p; i++) {
+      output[i + (size_t) j * p] = output[j + (size_t) i * p] = summary[index++];
+    }
+  }
+
+  // Free memory
+  free(summary);
+
+}
+
+// Interface with R (pack network)
+SEXP r_network_pack(SEXP r_network) {
+
+  // Get dimensions
+  int p = ncols(r_network);
+
+  // Initialize R result
+  SEXP r_packed = PROTECT(allocVector(RAWSXP, triangle_length(p) * sizeof(float)));
+
+  // Call the C function
+  pack_network(REAL(r_network), p, (float*) RAW(r_packed));
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_packed;
+
+}
+
+// Interface with R (unpack network)
+// `r_offset` is the position (in values) of the network in the store
+SEXP r_network_unpack(SEXP r_store, SEXP r_offset, SEXP r_p) {
+
+  // Get dimensions
+  int p = INTEGER(r_p)[0];
+  size_t offset = (size_t) REAL(r_offset)[0];
+
+  // Check bounds
+  if((offset + triangle_length(p)) * sizeof(float) > (size_t) XLENGTH(r_store)) {
+    Rf_error("Network is outside of the store. Terminating...");
+  }
+
+  // Initialize R result
+  SEXP r_network = PROTECT(allocMatrix(REALSXP, p, p));
+
+  // Call the C function
+  unpack_network(&((const float*) RAW(r_store))[offset], p, REAL(r_network));
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_network;
+
+}
+
+// Interface with R (summary of networks)
+// `r_statistic`: 0 = median, 1 = mean, 2 = edge frequency
+SEXP r_network_summary(SEXP r_store, SEXP r_p, SEXP r_statistic, SEXP r_ncores) {
+
+  // Get dimensions
+  int p = INTEGER(r_p)[0];
+  int networks = (int) (XLENGTH(r_store) / sizeof(float) / triangle_length(p));
+
+  // Initialize R result
+  SEXP r_summary = PROTECT(allocMatrix(REALSXP, p, p));
+
+  // Call the C function
+  summarize_networks(
+    (const float*) RAW(r_store), networks, p, INTEGER(r_statistic)[0],
+    INTEGER(r_ncores)[0], REAL(r_summary)
+  );
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_summary;
+
+}
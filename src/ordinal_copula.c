@@ -0,0 +1,172 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "ziggurat.h"
+#include "xoshiro.h"
+#include "nanotime.h"
+#include "polychoric_matrix.h" // for `CUT`
+
+/*
+
+ Gaussian copula for ordinal data
+
+ Generates multivariate normal data (`Z %*% factor`) and
+ categorizes it with per-variable thresholds in a single pass
+ without intermediate continuous matrices
+
+ Categories start at 1 and are returned as an integer matrix
+ (rows = cases, columns = variables) that can be passed directly
+ to `r_polychoric_correlation_matrix` (maximum number of categories
+ is `CUT - 1` so that all categories fit in the joint frequency table)
+
+*/
+
+// Category lookup (thresholds are sorted and few)
+static inline int categorize(double value, const double* threshold, int n_thresholds) {
+
+  // Initialize category
+  int category = 1;
+
+  // Count thresholds at or below value
+  while(category <= n_thresholds && value >= threshold[category - 1]) {
+    category++;
+  }
+
+  // Return category
+  return category;
+
+}
+
+// Generate ordinal data
+void ordinal_copula(
+    int cases, int cols, double* factor,
+    double** thresholds, int* n_thresholds,
+    xoshiro256_state* state, int* output
+) {
+
+  // Initialize iterators
+  int i, j, k;
+  double value;
+
+  // Initialize normal draws
+  double* z = (double*) malloc(cols * sizeof(double));
+
+  // Initialize non-zero range of each factor column
+  // (skips zeros in triangular factors like `chol`)
+  int* first_row = (int*) malloc(cols * sizeof(int));
+  int* last_row = (int*) malloc(cols * sizeof(int));
+
+  // Determine non-zero ranges
+  for(j = 0; j < cols; j++) {
+
+    // Set defaults (empty range)
+    first_row[j] = cols;
+    last_row[j] = -1;
+
+    // Find first and last non-zero
+    for(k = 0; k < cols; k++) {
+      if(factor[k + j * cols] != 0) {
+        if(first_row[j] == cols) {
+          first_row[j] = k;
+        }
+        last_row[j] = k;
+      }
+    }
+
+  }
+
+  // Loop over cases
+  for(i = 0; i < cases; i++) {
+
+    // Draw standard normals
+    for(k = 0; k < cols; k++) {
+      z[k] = r8_nor(state);
+    }
+
+    // Loop over variables
+    for(j = 0; j < cols; j++) {
+
+      // Linear transform
+      value = 0.0;
+      for(k = first_row[j]; k <= last_row[j]; k++) {
+        value += z[k] * factor[k + j * cols];
+      }
+
+      // Categorize
+      output[i + j * cases] = categorize(value, thresholds[j], n_thresholds[j]);
+
+    }
+
+  }
+
+  // Free memory
+  free(z);
+  free(first_row);
+  free(last_row);
+
+}
+
+// Interface with R
+SEXP r_ordinal_copula(
+    SEXP r_cases, SEXP r_factor,
+    SEXP r_thresholds, SEXP r_seed
+) {
+
+  // Initialize values
+  int cases = INTEGER(r_cases)[0];
+  int cols = ncols(r_factor);
+  uint64_t seed_value = (uint64_t) REAL(r_seed)[0];
+
+  // For random seed, use zero
+  if(seed_value == 0) { // Use clocktime in nanoseconds
+    seed_value = get_time_ns();
+  }
+
+  // Check thresholds
+  if(length(r_thresholds) != cols) {
+    Rf_error("Number of threshold vectors must equal the number of variables. Terminating...");
+  }
+
+  // Set up thresholds
+  double** thresholds = (double**) R_alloc(cols, sizeof(double*));
+  int* n_thresholds = (int*) R_alloc(cols, sizeof(int));
+
+  // Obtain pointers and lengths
+  for(int j = 0; j < cols; j++) {
+
+    // Get threshold vector
+    SEXP r_threshold = VECTOR_ELT(r_thresholds, j);
+
+    // Set values
+    thresholds[j] = REAL(r_threshold);
+    n_thresholds[j] = length(r_threshold);
+
+    // Validate number of categories
+    if(n_thresholds[j] > CUT - 2) {
+      Rf_error("Too many thresholds for variable %d (maximum is %d). Terminating...", j + 1, CUT - 2);
+    }
+
+  }
+
+  // Seed the random number generator
+  xoshiro256_state state;
+  seed_xoshiro256(&state, seed_value);
+
+  // Create R matrix
+  SEXP r_output = PROTECT(allocMatrix(INTSXP, cases, cols));
+
+  // Call the C function
+  ordinal_copula(
+    cases, cols, REAL(r_factor),
+    thresholds, n_thresholds,
+    &state, INTEGER(r_output)
+  );
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
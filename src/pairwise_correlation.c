@@ -0,0 +1,427 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "bitset.h"
+
+/*
+
+ Pairwise-complete Pearson and Spearman correlations
+
+ Same as `cor(data, use = "pairwise.complete.obs", method)` for
+ Pearson and Spearman without the per-pair recomputation in R
+
+ Missingness of each column is stored as a bitmask of observed
+ rows. Data are centered at each column's mean (missing values set
+ to zero) so that the pairwise-complete sums, sums of squares, and
+ cross-products of a pair can be accumulated in a single branch-free
+ pass (observed indicators multiply out missing values). Pairs where
+ both columns are complete reduce to a cross-product
+
+ Spearman: columns are ranked once (average ties). Pairs with
+ missing values are re-ranked over their complete rows (as `cor`
+ does) by walking each column's pre-sorted order and skipping rows
+ missing in the other column, which is O(n) per pair
+
+ Pairs are processed in tiles of columns in parallel
+
+*/
+
+// Number of columns in a tile
+#define TILE 32
+
+// Column summaries
+typedef struct {
+  int n;
+  int p;
+  double* centered; // centered data (missing = 0)
+  double* observed; // observed indicators (1 or 0)
+  uint64_t* mask; // observed rows
+  int words;
+  int* n_observed; // observed rows in each column
+  double* sum_squares; // sum of squared centered data
+  int* order; // rows of each column sorted by value (Spearman)
+} correlation_data;
+
+// Value with row for sorting
+typedef struct {
+  double value;
+  int row;
+} ranked_value;
+
+// Compare values (ascending, ties by row)
+static int compare_value(const void* a, const void* b) {
+
+  // Get values
+  const ranked_value* x = (const ranked_value*) a;
+  const ranked_value* y = (const ranked_value*) b;
+
+  // Compare values then rows
+  if(x->value != y->value) {
+    return (x->value > y->value) ? 1 : -1;
+  }
+  return (x->row > y->row) - (x->row < y->row);
+
+}
+
+// Rank observed values of a column (average ties)
+// `order` receives the observed rows in sorted order
+static int rank_column(
+    const double* column, int n, double* ranks, int* order, ranked_value* buffer
+) {
+
+  // Collect observed values
+  int m = 0;
+  for(int i = 0; i < n; i++) {
+    if(!ISNAN(column[i])) {
+      buffer[m].value = column[i];
+      buffer[m++].row = i;
+    }
+  }
+
+  // Sort values
+  qsort(buffer, m, sizeof(ranked_value), compare_value);
+
+  // Assign average ranks
+  for(int start = 0; start < m; ) {
+    int end = start + 1;
+    while(end < m && buffer[end].value == buffer[start].value) {
+      end++;
+    }
+    double rank = (start + end + 1) / 2.0;
+    for(int k = start; k < end; k++) {
+      ranks[buffer[k].row] = rank;
+      order[k] = buffer[k].row;
+    }
+    start = end;
+  }
+
+  // Return number observed
+  return m;
+
+}
+
+// Set up column summaries
+static void prepare_data(
+    const double* data, int n, int p, int spearman, correlation_data* D
+) {
+
+  // Set dimensions
+  D->n = n;
+  D->p = p;
+  D->words = BITSET_WORDS(n);
+
+  // Allocate memory
+  D->centered = (double*) malloc((size_t) n * p * sizeof(double));
+  D->observed = (double*) malloc((size_t) n * p * sizeof(double));
+  D->mask = (uint64_t*) calloc((size_t) D->words * p, sizeof(uint64_t));
+  D->n_observed = (int*) malloc(p * sizeof(int));
+  D->sum_squares = (double*) malloc(p * sizeof(double));
+  D->order = spearman ? (int*) malloc((size_t) n * p * sizeof(int)) : NULL;
+  double* ranks = spearman ? (double*) malloc(n * sizeof(double)) : NULL;
+  ranked_value* buffer = spearman ? (ranked_value*) malloc(n * sizeof(ranked_value)) : NULL;
+
+  // Loop over columns
+  for(int j = 0; j < p; j++) {
+
+    // Get column
+    const double* column = &data[(size_t) j * n];
+    double* centered = &D->centered[(size_t) j * n];
+    double* observed = &D->observed[(size_t) j * n];
+    uint64_t* mask = &D->mask[(size_t) j * D->words];
+
+    // Ranks (Spearman) or values
+    const double* values = column;
+    if(spearman) {
+      rank_column(column, n, ranks, &D->order[(size_t) j * n], buffer);
+      values = ranks;
+    }
+
+    // Mean of observed values
+    int m = 0;
+    long double sum = 0.0L;
+    for(int i = 0; i < n; i++) {
+      if(!ISNAN(column[i])) {
+        bitset_set(mask, i);
+        sum += values[i];
+        m++;
+      }
+    }
+    double mean = (m > 0) ? (double) (sum / m) : 0.0;
+
+    // Center values
+    double squares = 0.0;
+    for(int i = 0; i < n; i++) {
+      if(ISNAN(column[i])) {
+        centered[i] = 0.0;
+        observed[i] = 0.0;
+      }else{
+        centered[i] = values[i] - mean;
+        observed[i] = 1.0;
+        squares += centered[i] * centered[i];
+      }
+    }
+
+    // Store summaries
+    D->n_observed[j] = m;
+    D->sum_squares[j] = squares;
+
+  }
+
+  // Free memory
+  free(ranks);
+  free(buffer);
+
+}
+
+// Free column summaries
+static void free_data(correlation_data* D) {
+  free(D->centered);
+  free(D->observed);
+  free(D->mask);
+  free(D->n_observed);
+  free(D->sum_squares);
+  free(D->order);
+}
+
+// Correlation from pairwise sums (NA for fewer than two
+// observations or zero variance)
+static inline double sums_correlation(
+    int count, double sum_x, double sum_y, double sum_xx,
+    double sum_yy, double sum_xy
+) {
+
+  // Check for observations
+  if(count < 2) {
+    return NA_REAL;
+  }
+
+  // Centered sums
+  double xx = sum_xx - sum_x * sum_x / count;
+  double yy = sum_yy - sum_y * sum_y / count;
+  double xy = sum_xy - sum_x * sum_y / count;
+
+  // Check for variance
+  if(xx <= 0.0 || yy <= 0.0) {
+    return NA_REAL;
+  }
+
+  // Correlation (bounded)
+  double r = xy / (sqrt(xx) * sqrt(yy));
+  return (r > 1.0) ? 1.0 : (r < -1.0) ? -1.0 : r;
+
+}
+
+// Pearson correlation of a pair
+static double pearson_pair(const correlation_data* D, int a, int b) {
+
+  // Get columns
+  int n = D->n;
+  const double* x = &D->centered[(size_t) a * n];
+  const double* y = &D->centered[(size_t) b * n];
+
+  // Both complete: cross-product only
+  if(D->n_observed[a] == n && D->n_observed[b] == n) {
+    double sum_xy = 0.0;
+    for(int i = 0; i < n; i++) {
+      sum_xy += x[i] * y[i];
+    }
+    return sums_correlation(n, 0.0, 0.0, D->sum_squares[a], D->sum_squares[b], sum_xy);
+  }
+
+  // Pairwise-complete observations
+  int count = bitset_intersect_count(
+    &D->mask[(size_t) a * D->words], &D->mask[(size_t) b * D->words], D->words
+  );
+
+  // Pairwise sums (missing values multiply out)
+  const double* mx = &D->observed[(size_t) a * n];
+  const double* my = &D->observed[(size_t) b * n];
+  double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_yy = 0.0, sum_xy = 0.0;
+  for(int i = 0; i < n; i++) {
+    double xi = x[i] * my[i], yi = y[i] * mx[i];
+    sum_x += xi;
+    sum_y += yi;
+    sum_xx += xi * x[i];
+    sum_yy += yi * y[i];
+    sum_xy += x[i] * y[i];
+  }
+
+  // Return correlation
+  return sums_correlation(count, sum_x, sum_y, sum_xx, sum_yy, sum_xy);
+
+}
+
+// Ranks of column `a` over rows observed in column `b`
+static int pair_ranks(
+    const correlation_data* D, int a, int b, const double* data, double* ranks
+) {
+
+  // Get sorted rows and mask
+  int n = D->n;
+  const int* order = &D->order[(size_t) a * n];
+  const double* column = &data[(size_t) a * n];
+  const uint64_t* mask = &D->mask[(size_t) b * D->words];
+
+  // Walk sorted rows (skip rows missing in `b`)
+  int m = 0, start = 0, k = 0, total = D->n_observed[a];
+  while(k < total) {
+
+    // Find tied run among kept rows
+    double value = column[order[k]];
+    int end = k, kept = 0;
+    while(end < total && column[order[end]] == value) {
+      kept += bitset_test(mask, order[end]);
+      end++;
+    }
+
+    // Assign average rank
+    double rank = start + (kept + 1) / 2.0;
+    for(int t = k; t < end; t++) {
+      if(bitset_test(mask, order[t])) {
+        ranks[order[t]] = rank;
+        m++;
+      }
+    }
+
+    // Move to next run
+    start += kept;
+    k = end;
+
+  }
+
+  // Return number of ranks
+  return m;
+
+}
+
+// Spearman correlation of a pair
+static double spearman_pair(
+    const correlation_data* D, int a, int b, const double* data,
+    double* rank_x, double* rank_y
+) {
+
+  // Both complete or no missing values in common rows: global ranks
+  int n = D->n;
+  int count = bitset_intersect_count(
+    &D->mask[(size_t) a * D->words], &D->mask[(size_t) b * D->words], D->words
+  );
+  if(count == D->n_observed[a] && count == D->n_observed[b]) {
+    return pearson_pair(D, a, b);
+  }
+
+  // Check for observations
+  if(count < 2) {
+    return NA_REAL;
+  }
+
+  // Re-rank over pairwise-complete rows
+  pair_ranks(D, a, b, data, rank_x);
+  pair_ranks(D, b, a, data, rank_y);
+
+  // Centered sums (mean rank is known)
+  const uint64_t* mask_a = &D->mask[(size_t) a * D->words];
+  const uint64_t* mask_b = &D->mask[(size_t) b * D->words];
+  double mean = (count + 1) / 2.0;
+  double sum_xx = 0.0, sum_yy = 0.0, sum_xy = 0.0;
+  for(int i = 0; i < n; i++) {
+    if(bitset_test(mask_a, i) && bitset_test(mask_b, i)) {
+      double x = rank_x[i] - mean, y = rank_y[i] - mean;
+      sum_xx += x * x;
+      sum_yy += y * y;
+      sum_xy += x * y;
+    }
+  }
+
+  // Return correlation
+  return sums_correlation(count, 0.0, 0.0, sum_xx, sum_yy, sum_xy);
+
+}
+
+// Correlation matrix
+static void pairwise_correlation(
+    const double* data, int n, int p, int spearman, int n_threads,
+    double* output
+) {
+
+  // Set up column summaries
+  correlation_data D;
+  prepare_data(data, n, p, spearman, &D);
+
+  // Tiles (upper triangle, including diagonal)
+  int tiles = (p + TILE - 1) / TILE;
+  int tile_pairs = tiles * (tiles + 1) / 2;
+
+  #pragma omp parallel num_threads(n_threads)
+  {
+
+    // Per thread memory (Spearman ranks)
+    double* rank_x = spearman ? (double*) malloc(n * sizeof(double)) : NULL;
+    double* rank_y = spearman ? (double*) malloc(n * sizeof(double)) : NULL;
+
+    #pragma omp for schedule(dynamic)
+    for(int t = 0; t < tile_pairs; t++) {
+
+      // Get tiles
+      int tile_a = 0, remaining = t;
+      while(remaining >= tiles - tile_a) {
+        remaining -= tiles - tile_a;
+        tile_a++;
+      }
+      int tile_b = tile_a + remaining;
+
+      // Tile bounds
+      int a_end = (tile_a + 1) * TILE < p ? (tile_a + 1) * TILE : p;
+      int b_end = (tile_b + 1) * TILE < p ? (tile_b + 1) * TILE : p;
+
+      // Loop over pairs in tiles
+      for(int a = tile_a * TILE; a < a_end; a++) {
+        for(int b = (tile_a == tile_b) ? a : tile_b * TILE; b < b_end; b++) {
+          double r = spearman ?
+            spearman_pair(&D, a, b, data, rank_x, rank_y) :
+            pearson_pair(&D, a, b);
+          if(a == b && !ISNAN(r)) {
+            r = 1.0; // exact diagonal (as `cor`)
+          }
+          output[a + (size_t) b * p] = output[b + (size_t) a * p] = r;
+        }
+      }
+
+    }
+
+    // Free memory
+    free(rank_x);
+    free(rank_y);
+
+  }
+
+  // Free memory
+  free_data(&D);
+
+}
+
+// Interface with R
+SEXP r_pairwise_correlation(SEXP r_data, SEXP r_spearman, SEXP r_ncores) {
+
+  // Get dimensions
+  int n = nrows(r_data);
+  int p = ncols(r_data);
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocMatrix(REALSXP, p, p));
+
+  // Call the C function
+  pairwise_correlation(
+    REAL(r_data), n, p, LOGICAL(r_spearman)[0],
+    INTEGER(r_ncores)[0], REAL(r_output)
+  );
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
@@ -0,0 +1,118 @@
+#include <math.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Streaming accumulator for permutation tests
+
+ Per-element exceedance counts and Welford running mean and
+ sum of squared deviations, updated with each batch of permutation
+ results so that memory does not grow with the number of
+ permutations
+
+ Directions: 0 = |x| >= |reference|, 1 = x <= reference
+
+ The state is a list with `reference`, `direction`, `n`, `mean`,
+ `squares`, `exceed`, `trials` and `missing` (see
+ `permutation_accumulator` in R)
+
+*/
+
+// Number of state elements
+#define STATE_LENGTH 8
+
+// Update state with one permutation
+static void accumulate_values(
+    const double* values, R_xlen_t length,
+    const double* reference, const int* direction, R_xlen_t direction_length,
+    double* n, double* mean, double* squares,
+    double* exceed, double* trials, double* missing
+) {
+
+  // Loop over elements
+  for(R_xlen_t k = 0; k < length; k++) {
+
+    // Get value
+    double value = values[k];
+
+    // Check for missing
+    if(ISNAN(value)) {
+      missing[k]++;
+      continue;
+    }
+
+    // Update mean and squares (Welford)
+    n[k]++;
+    double delta = value - mean[k];
+    mean[k] += delta / n[k];
+    squares[k] += delta * (value - mean[k]);
+
+    // Update exceedance
+    if(!ISNAN(reference[k])) {
+      trials[k]++;
+      if(direction[k % direction_length] == 0) {
+        exceed[k] += fabs(value) >= fabs(reference[k]);
+      }else{
+        exceed[k] += value <= reference[k];
+      }
+    }
+
+  }
+
+}
+
+// Interface with R
+// `r_values` is a list of permutation results (same length as reference)
+// Returns the updated state
+SEXP r_accumulate_permutations(SEXP r_state, SEXP r_values) {
+
+  // Get reference
+  SEXP r_reference = VECTOR_ELT(r_state, 0);
+  SEXP r_direction = VECTOR_ELT(r_state, 1);
+  R_xlen_t length = XLENGTH(r_reference);
+
+  // Initialize R result (copy state)
+  SEXP r_output = PROTECT(allocVector(VECSXP, STATE_LENGTH));
+  SET_VECTOR_ELT(r_output, 0, r_reference);
+  SET_VECTOR_ELT(r_output, 1, r_direction);
+  double* accumulators[STATE_LENGTH];
+  for(int s = 2; s < STATE_LENGTH; s++) {
+    SEXP r_accumulator = allocVector(REALSXP, length);
+    SET_VECTOR_ELT(r_output, s, r_accumulator);
+    accumulators[s] = REAL(r_accumulator);
+    memcpy(accumulators[s], REAL(VECTOR_ELT(r_state, s)), length * sizeof(double));
+  }
+  setAttrib(r_output, R_NamesSymbol, getAttrib(r_state, R_NamesSymbol));
+
+  // Loop over permutations
+  R_xlen_t permutations = XLENGTH(r_values);
+  for(R_xlen_t i = 0; i < permutations; i++) {
+
+    // Get values
+    SEXP r_permutation = VECTOR_ELT(r_values, i);
+
+    // Check length
+    if(XLENGTH(r_permutation) != length) {
+      UNPROTECT(1);
+      Rf_error("Permutation results must have the same length as the reference. Terminating...");
+    }
+
+    // Update state
+    accumulate_values(
+      REAL(r_permutation), length,
+      REAL(r_reference), INTEGER(r_direction), XLENGTH(r_direction),
+      accumulators[2], accumulators[3], accumulators[4],
+      accumulators[5], accumulators[6], accumulators[7]
+    );
+
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
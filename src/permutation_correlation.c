@@ -0,0 +1,348 @@
+#define USE_FC_LEN_T
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include <R_ext/BLAS.h>
+#include "polychoric_matrix.h"
+#ifndef FCONE
+# define FCONE
+#endif
+
+/*
+
+ Complement-based correlations for permutation tests
+
+ A permutation splits the pooled data into two groups whose
+ sufficient statistics always add up to the (fixed) pooled totals.
+ For Pearson correlations, the pooled statistics are computed once;
+ for each permutation, only the smaller group is accumulated and
+ the other group is obtained by subtraction
+
+ Pearson: cross-products of data centered at the pooled means.
+ With pooled centering, the group sums are negatives of each other
+ (S_a = -S_b) and the cross-products are C_b = C - C_a
+
+ Ordinal (polychoric): joint frequency tables of both groups are
+ built for one pair of variables at a time (in one pass over the
+ data with CUT x CUT scratch tables) and passed to the same
+ polychoric estimator used by `polychoric.matrix`; the polychoric
+ estimates dominate the cost, so no pooled tables are kept
+
+ Data must be complete (no missing values); ordinal data must be
+ coded between 0 and CUT - 1
+
+*/
+
+// Pooled Pearson statistics: pooled means (first p values)
+// followed by the p x p cross-products of centered data
+static void pooled_pearson(const double* data, int n, int p, double* output) {
+
+  // Initialize iterators
+  int i, j;
+
+  // Pooled means
+  double* means = output;
+  for(j = 0; j < p; j++) {
+    long double sum = 0.0L;
+    const double* column = &data[(size_t) j * n];
+    for(i = 0; i < n; i++) {
+      sum += column[i];
+    }
+    means[j] = (double) (sum / n);
+  }
+
+  // Centered data
+  double* centered = (double*) malloc((size_t) n * p * sizeof(double));
+  for(j = 0; j < p; j++) {
+    for(i = 0; i < n; i++) {
+      centered[i + (size_t) j * n] = data[i + (size_t) j * n] - means[j];
+    }
+  }
+
+  // Cross-products (lower triangle with `dsyrk`)
+  double* cross_products = &output[p];
+  double one = 1.0, zero = 0.0;
+  char uplo = 'L', trans = 'T';
+  F77_CALL(dsyrk)(
+    &uplo, &trans, &p, &n, &one, centered, &n, &zero, cross_products, &p
+    FCONE FCONE
+  );
+
+  // Free memory
+  free(centered);
+
+}
+
+// Joint frequency tables (CUT x CUT) of a pair of variables
+// for both groups (`group` is 1 for rows of the first group)
+static void pair_tables(
+    const int* column_i, const int* column_j, int n, const char* group,
+    int* first, int* second
+) {
+
+  // Initialize tables
+  memset(first, 0, CUT * CUT * sizeof(int));
+  memset(second, 0, CUT * CUT * sizeof(int));
+
+  // Count
+  for(int k = 0; k < n; k++) {
+    int* table = group[k] ? first : second;
+    table[column_i[k] * CUT + column_j[k]]++;
+  }
+
+}
+
+// Pearson correlations from complement
+static void permutation_pearson(
+    const double* data, int n, int p, const double* pooled,
+    const int* rows, int n_rows, double* smaller, double* larger
+) {
+
+  // Initialize iterators
+  int i, j;
+
+  // Pooled means and cross-products
+  const double* means = pooled;
+  const double* pooled_cross = &pooled[p];
+
+  // Gather centered rows of smaller group
+  double* gathered = (double*) malloc((size_t) n_rows * p * sizeof(double));
+  double* sums = (double*) calloc(p, sizeof(double));
+  for(j = 0; j < p; j++) {
+    const double* column = &data[(size_t) j * n];
+    double* target = &gathered[(size_t) j * n_rows];
+    double sum = 0.0;
+    for(i = 0; i < n_rows; i++) {
+      target[i] = column[rows[i]] - means[j];
+      sum += target[i];
+    }
+    sums[j] = sum;
+  }
+
+  // Cross-products of smaller group (lower triangle)
+  double* cross = (double*) malloc((size_t) p * p * sizeof(double));
+  double one = 1.0, zero = 0.0;
+  char uplo = 'L', trans = 'T';
+  F77_CALL(dsyrk)(
+    &uplo, &trans, &p, &n_rows, &one, gathered, &n_rows, &zero, cross, &p
+    FCONE FCONE
+  );
+
+  // Group sizes
+  double n_smaller = (double) n_rows;
+  double n_larger = (double) (n - n_rows);
+
+  // Covariances (stored in outputs, lower triangle)
+  for(j = 0; j < p; j++) {
+    for(i = j; i < p; i++) {
+      size_t index = i + (size_t) j * p;
+      double product = sums[i] * sums[j];
+      smaller[index] = cross[index] - product / n_smaller;
+      larger[index] = pooled_cross[index] - cross[index] - product / n_larger;
+    }
+  }
+
+  // Convert to correlations (fill both triangles)
+  for(j = 0; j < p; j++) {
+    size_t diagonal_j = j + (size_t) j * p;
+    for(i = j + 1; i < p; i++) {
+      size_t index = i + (size_t) j * p;
+      size_t diagonal_i = i + (size_t) i * p;
+      smaller[index] /= sqrt(smaller[diagonal_i] * smaller[diagonal_j]);
+      larger[index] /= sqrt(larger[diagonal_i] * larger[diagonal_j]);
+      smaller[j + (size_t) i * p] = smaller[index];
+      larger[j + (size_t) i * p] = larger[index];
+    }
+  }
+
+  // Set diagonal (zero variance is undefined)
+  for(j = 0; j < p; j++) {
+    size_t diagonal = j + (size_t) j * p;
+    smaller[diagonal] = (smaller[diagonal] > 0.0) ? 1.0 : NA_REAL;
+    larger[diagonal] = (larger[diagonal] > 0.0) ? 1.0 : NA_REAL;
+  }
+
+  // Free memory
+  free(gathered);
+  free(sums);
+  free(cross);
+
+}
+
+// Number of non-empty categories of `X` in a table
+static int table_categories(const int* table, int X) {
+
+  // Initialize categories
+  int categories = 0;
+
+  // Loop over categories
+  for(int k = 0; k < CUT; k++) {
+
+    // Initialize sum
+    int sum = 0;
+
+    // Margin
+    for(int l = 0; l < CUT; l++) {
+      sum += X ? table[k * CUT + l] : table[l * CUT + k];
+    }
+
+    // Count non-empty
+    categories += sum != 0;
+
+  }
+
+  // Return categories
+  return categories;
+
+}
+
+// Polychoric correlation of a pair (NA with fewer than two categories)
+static double pair_polychoric(
+    int* table, int cases, int empty_method, double empty_value
+) {
+
+  // Check for constant variables (same as zero standard deviation)
+  if(table_categories(table, 1) < 2 || table_categories(table, 0) < 2) {
+    return NA_REAL;
+  }
+
+  // Set up rows
+  int* rows[CUT];
+  for(int k = 0; k < CUT; k++) {
+    rows[k] = &table[k * CUT];
+  }
+
+  // Return polychoric correlation
+  return polychoric_table(rows, cases, empty_method, empty_value);
+
+}
+
+// Polychoric correlations of both groups
+static void permutation_polychoric(
+    const int* data, int n, int p, const char* group, int n_first,
+    int empty_method, double empty_value, double* first, double* second
+) {
+
+  // Scratch tables (re-used for every pair)
+  int first_table[CUT * CUT], second_table[CUT * CUT];
+
+  // Loop over pairs
+  for(int i = 0; i < p; i++) {
+
+    // Set diagonal
+    first[i + (size_t) i * p] = second[i + (size_t) i * p] = 1.0;
+
+    // Loop over other variables
+    const int* column_i = &data[(size_t) i * n];
+    for(int j = i + 1; j < p; j++) {
+
+      // Tables
+      pair_tables(
+        column_i, &data[(size_t) j * n], n, group,
+        first_table, second_table
+      );
+
+      // Correlations
+      first[i + (size_t) j * p] = first[j + (size_t) i * p] =
+        pair_polychoric(first_table, n_first, empty_method, empty_value);
+      second[i + (size_t) j * p] = second[j + (size_t) i * p] =
+        pair_polychoric(second_table, n - n_first, empty_method, empty_value);
+
+    }
+
+  }
+
+}
+
+// Interface with R (pooled statistics)
+// Ordinal data have no pooled statistics (`NULL`)
+SEXP r_permutation_pooled(SEXP r_data) {
+
+  // Check for ordinal
+  if(isInteger(r_data)) {
+    return R_NilValue;
+  }
+
+  // Get dimensions
+  int n = nrows(r_data);
+  int p = ncols(r_data);
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocVector(REALSXP, (R_xlen_t) (p + 1) * p));
+  pooled_pearson(REAL(r_data), n, p, REAL(r_output));
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
+
+// Interface with R (one permutation)
+// `r_index` are the (1-based) rows of the first group
+// Returns a list with the correlations of the first and second group
+SEXP r_permutation_correlation(
+    SEXP r_data, SEXP r_pooled, SEXP r_index,
+    SEXP r_empty_method, SEXP r_empty_value
+) {
+
+  // Get dimensions
+  int n = nrows(r_data);
+  int p = ncols(r_data);
+  int n_index = length(r_index);
+
+  // Mark rows of first group
+  char* first = (char*) R_alloc(n, sizeof(char));
+  memset(first, 0, n);
+  int* index = INTEGER(r_index);
+  for(int k = 0; k < n_index; k++) {
+    first[index[k] - 1] = 1;
+  }
+
+  // Initialize R results
+  SEXP r_first = PROTECT(allocMatrix(REALSXP, p, p));
+  SEXP r_second = PROTECT(allocMatrix(REALSXP, p, p));
+
+  // Call the C function
+  if(isInteger(r_data)) {
+    permutation_polychoric(
+      INTEGER(r_data), n, p, first, n_index,
+      INTEGER(r_empty_method)[0], REAL(r_empty_value)[0],
+      REAL(r_first), REAL(r_second)
+    );
+  }else{
+
+    // Accumulate the smaller group
+    int use_first = n_index <= n - n_index;
+    int n_rows = use_first ? n_index : n - n_index;
+    int* rows = (int*) R_alloc(n_rows, sizeof(int));
+    for(int k = 0, r = 0; k < n; k++) {
+      if(first[k] == use_first) {
+        rows[r++] = k;
+      }
+    }
+
+    // Correlations from complement
+    permutation_pearson(
+      REAL(r_data), n, p, REAL(r_pooled), rows, n_rows,
+      use_first ? REAL(r_first) : REAL(r_second),
+      use_first ? REAL(r_second) : REAL(r_first)
+    );
+
+  }
+
+  // Set up list
+  SEXP r_output = PROTECT(allocVector(VECSXP, 2));
+  SET_VECTOR_ELT(r_output, 0, r_first);
+  SET_VECTOR_ELT(r_output, 1, r_second);
+
+  // Release protected SEXP objects
+  UNPROTECT(3);
+
+  // Return result
+  return r_output;
+
+}
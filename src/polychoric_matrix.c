@@ -266,18 +266,13 @@ struct ThresholdsResult {
   int cat_Y;
 };
 
-// Compute thresholds
-struct ThresholdsResult thresholds(int* input_data, int rows, int i, int j, int empty_method, double empty_value) {
+// Compute thresholds from a joint frequency table
+// `cases_observed` is the number of observations in the table
+struct ThresholdsResult table_thresholds(int** joint_frequency_max, int cases_observed, int empty_method, double empty_value) {
 
   // Initialize iterators
   int k, l;
 
-  // Initialize missing
-  int missing = 0;
-
-  // Obtain joint frequency table
-  int** joint_frequency_max = joint_frequency_table(input_data, rows, i, j, &missing);
-
   // Initialize categories
   int cat_X = 0;
   int cat_Y = 0;
@@ -288,10 +283,6 @@ struct ThresholdsResult thresholds(int* input_data, int rows, int i, int j, int
   // Update joint frequency table (remove zero rows)
   double** joint_frequency = update_joint_frequency(joint_frequency_max, &cat_X, &cat_Y, &zero_count);
 
-  // Free memory
-  free(joint_frequency_max[0]);
-  free(joint_frequency_max);
-
   // Initialize added value
   double added_value = 0.0;
   double added_sum = 0.0;
@@ -362,7 +353,7 @@ struct ThresholdsResult thresholds(int* input_data, int rows, int i, int j, int
   }
 
   // Compute cases
-  double cases = rows - missing + added_sum;
+  double cases = cases_observed + added_sum;
 
   // Convert frequencies to probabilities
   compute_probabilities(frequency_X, cat_X, cases);
@@ -394,6 +385,29 @@ struct ThresholdsResult thresholds(int* input_data, int rows, int i, int j, int
   return result;
 }
 
+// Compute thresholds
+struct ThresholdsResult thresholds(int* input_data, int rows, int i, int j, int empty_method, double empty_value) {
+
+  // Initialize missing
+  int missing = 0;
+
+  // Obtain joint frequency table
+  int** joint_frequency_max = joint_frequency_table(input_data, rows, i, j, &missing);
+
+  // Compute thresholds
+  struct ThresholdsResult result = table_thresholds(
+    joint_frequency_max, rows - missing, empty_method, empty_value
+  );
+
+  // Free memory
+  free(joint_frequency_max[0]);
+  free(joint_frequency_max);
+
+  // Return
+  return result;
+
+}
+
 // Error function
 static inline double error_function(double x) {
 
@@ -782,11 +796,8 @@ double optimize(double (*f)(double, double**, double*, double*, double*, double*
   return x;
 }
 
-// Compute polychoric correlation
-double polychoric(int* input_data, int rows, int i, int j, int empty_method, double empty_value) {
-
-  // Obtain joint frequency table, probability_X, and probability_Y from thresholds function
-  struct ThresholdsResult thresholds_result = thresholds(input_data, rows, i, j, empty_method, empty_value);
+// Compute polychoric correlation from thresholds
+static double polychoric_thresholds(struct ThresholdsResult thresholds_result) {
 
   // Perform optimization
   double rho_optimum = optimize(
@@ -809,6 +820,24 @@ double polychoric(int* input_data, int rows, int i, int j, int empty_method, dou
 
 }
 
+// Compute polychoric correlation from a joint frequency table
+// (CUT x CUT counts with `cases` observations)
+double polychoric_table(int** joint_frequency, int cases, int empty_method, double empty_value) {
+  return polychoric_thresholds(
+    table_thresholds(joint_frequency, cases, empty_method, empty_value)
+  );
+}
+
+// Compute polychoric correlation
+double polychoric(int* input_data, int rows, int i, int j, int empty_method, double empty_value) {
+
+  // Obtain joint frequency table, probability_X, and probability_Y from thresholds function
+  return polychoric_thresholds(
+    thresholds(input_data, rows, i, j, empty_method, empty_value)
+  );
+
+}
+
 // The updated polychoric_correlation_matrix function
 void polychoric_correlation_matrix(
     int* input_data, int rows, int cols,
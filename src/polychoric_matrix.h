@@ -36,4 +36,7 @@ extern const double DOUBLE_W[5];
 #define MAX_ITER 100
 #define ZEPS 1e-10
 
+// Polychoric correlation from a CUT x CUT joint frequency table
+double polychoric_table(int** joint_frequency, int cases, int empty_method, double empty_value);
+
 #endif /* POLYCHORIC_H */
@@ -0,0 +1,632 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Resolution path for community detection (`EGA.fit`)
+
+ Louvain-type search (local moving of nodes followed by aggregation
+ of communities) for every value of a resolution grid. The grid is
+ swept from the largest to the smallest resolution and each search
+ starts from the previous partition (warm start): lowering the
+ resolution only merges communities, which aggregation handles well
+
+ Objective (up to a constant), linear in the resolution gamma:
+
+   Q = sum_c [ A_in(c) - gamma * (S+_c^2 / D+ - S-_c^2 / D-) ]
+
+ where A_in(c) are the (signed) edge weights within community c
+ (ordered pairs) and S_c are the sums of node weights in c
+
+ Modularity (signed; Gomez et al., 2009): node weights are positive
+ and negative strengths, D+ and D- are total strengths
+ CPM (Constant Potts Model): node weights are one, D+ = 1 (no negative)
+
+ Every move or merge has a gain a - gamma * b, so the range of
+ resolutions over which a partition is unchanged (no improving node
+ move or community merge) is found directly; grid points in that
+ range are copied without a search
+
+ Segments of the grid are searched in parallel (each segment starts
+ from singletons), so results do not depend on the number of cores
+
+*/
+
+// Grid points in a segment
+#define PATH_SEGMENT 16
+
+// Maximum passes of local moving
+#define MAX_PASSES 100
+
+// Tolerance for improvement
+#define GAIN_TOLERANCE 1e-10
+
+// Network at a level of aggregation
+typedef struct {
+  int n;
+  double* adjacency; // n x n (zero diagonal)
+  double* positive; // node weights (positive)
+  double* negative; // node weights (negative)
+} path_graph;
+
+// Objective
+typedef struct {
+  double positive_total;
+  double negative_total; // zero for none
+} path_objective;
+
+// Workspace of a search
+typedef struct {
+  path_graph graph;
+  double* buffer; // aggregation
+  double* community_positive;
+  double* community_negative;
+  double* neighbor_weight;
+  int* count;
+  int* touched;
+  int* membership;
+  int* node_map;
+  int* labels;
+} path_workspace;
+
+// Allocate workspace
+static void workspace_allocate(int p, path_workspace* W) {
+  size_t size = (size_t) p * p;
+  W->graph.adjacency = (double*) malloc(size * sizeof(double));
+  W->graph.positive = (double*) malloc(p * sizeof(double));
+  W->graph.negative = (double*) malloc(p * sizeof(double));
+  W->buffer = (double*) malloc(size * sizeof(double));
+  W->community_positive = (double*) malloc(p * sizeof(double));
+  W->community_negative = (double*) malloc(p * sizeof(double));
+  W->neighbor_weight = (double*) calloc(p, sizeof(double));
+  W->count = (int*) malloc(p * sizeof(int));
+  W->touched = (int*) malloc(p * sizeof(int));
+  W->membership = (int*) malloc(p * sizeof(int));
+  W->node_map = (int*) malloc(p * sizeof(int));
+  W->labels = (int*) malloc(p * sizeof(int));
+}
+
+// Free workspace
+static void workspace_free(path_workspace* W) {
+  free(W->graph.adjacency);
+  free(W->graph.positive);
+  free(W->graph.negative);
+  free(W->buffer);
+  free(W->community_positive);
+  free(W->community_negative);
+  free(W->neighbor_weight);
+  free(W->count);
+  free(W->touched);
+  free(W->membership);
+  free(W->node_map);
+  free(W->labels);
+}
+
+// Penalty slope of adding node weights to a community
+static inline double penalty(
+    const path_objective* objective, double node_positive, double node_negative,
+    double community_positive, double community_negative
+) {
+
+  // Positive part
+  double value = node_positive * community_positive / objective->positive_total;
+
+  // Negative part
+  if(objective->negative_total > 0) {
+    value -= node_negative * community_negative / objective->negative_total;
+  }
+
+  // Return penalty
+  return 2 * value;
+
+}
+
+// Relabel memberships (0, 1, ... in order of first appearance)
+// Returns the number of communities
+static int relabel(int* membership, int n, int* labels) {
+
+  // Initialize labels
+  for(int i = 0; i < n; i++) {
+    labels[i] = -1;
+  }
+
+  // Assign labels
+  int k = 0;
+  for(int i = 0; i < n; i++) {
+    if(labels[membership[i]] == -1) {
+      labels[membership[i]] = k++;
+    }
+    membership[i] = labels[membership[i]];
+  }
+
+  // Return number of communities
+  return k;
+
+}
+
+// Community sums and counts
+static void community_sums(
+    const path_graph* G, const int* membership, path_workspace* W
+) {
+
+  // Reset sums
+  for(int c = 0; c < G->n; c++) {
+    W->community_positive[c] = W->community_negative[c] = 0.0;
+    W->count[c] = 0;
+  }
+
+  // Add nodes
+  for(int i = 0; i < G->n; i++) {
+    int c = membership[i];
+    W->community_positive[c] += G->positive[i];
+    W->community_negative[c] += G->negative[i];
+    W->count[c]++;
+  }
+
+}
+
+// Weights from node `i` to neighboring communities
+// Returns the number of touched communities
+static int neighbor_weights(
+    const path_graph* G, const int* membership, int i, path_workspace* W
+) {
+
+  // Initialize touched
+  int n_touched = 0;
+
+  // Loop over neighbors
+  const double* column = &G->adjacency[(size_t) i * G->n];
+  for(int j = 0; j < G->n; j++) {
+    if(column[j] != 0.0) {
+      int d = membership[j];
+      if(W->neighbor_weight[d] == 0.0) {
+        W->touched[n_touched++] = d;
+      }
+      W->neighbor_weight[d] += column[j];
+    }
+  }
+
+  // Return number touched
+  return n_touched;
+
+}
+
+// Local moving of nodes (returns the number of moves)
+static int local_moving(
+    const path_graph* G, const path_objective* objective, double gamma,
+    int* membership, path_workspace* W
+) {
+
+  // Set up community sums
+  community_sums(G, membership, W);
+
+  // Initialize moves
+  int total = 0, moved, pass = 0;
+
+  // Passes over nodes
+  do {
+
+    // Initialize pass
+    moved = 0;
+
+    // Loop over nodes
+    for(int i = 0; i < G->n; i++) {
+
+      // Remove node from community
+      int c = membership[i];
+      double node_positive = G->positive[i], node_negative = G->negative[i];
+      W->community_positive[c] -= node_positive;
+      W->community_negative[c] -= node_negative;
+      W->count[c]--;
+
+      // Weights to neighboring communities
+      int n_touched = neighbor_weights(G, membership, i, W);
+
+      // Score of current community
+      int best = c;
+      double best_score = 2 * W->neighbor_weight[c] - gamma * penalty(
+        objective, node_positive, node_negative,
+        W->community_positive[c], W->community_negative[c]
+      );
+
+      // Scores of neighboring communities
+      for(int t = 0; t < n_touched; t++) {
+        int d = W->touched[t];
+        double score = 2 * W->neighbor_weight[d] - gamma * penalty(
+          objective, node_positive, node_negative,
+          W->community_positive[d], W->community_negative[d]
+        );
+        if(score > best_score + GAIN_TOLERANCE) {
+          best = d;
+          best_score = score;
+        }
+        W->neighbor_weight[d] = 0.0;
+      }
+
+      // Empty community (score is zero)
+      if(W->count[c] > 0 && 0.0 > best_score + GAIN_TOLERANCE) {
+        for(int d = 0; d < G->n; d++) {
+          if(W->count[d] == 0) {
+            best = d;
+            break;
+          }
+        }
+      }
+
+      // Add node to best community
+      membership[i] = best;
+      W->community_positive[best] += node_positive;
+      W->community_negative[best] += node_negative;
+      W->count[best]++;
+
+      // Count move
+      moved += best != c;
+
+    }
+
+    // Update total
+    total += moved;
+
+  } while(moved > 0 && ++pass < MAX_PASSES);
+
+  // Return total moves
+  return total;
+
+}
+
+// Aggregate communities into nodes (`k` communities)
+static void aggregate(path_graph* G, const int* membership, int k, path_workspace* W) {
+
+  // Initialize aggregated network
+  memset(W->buffer, 0, (size_t) k * k * sizeof(double));
+
+  // Sum edges between communities
+  for(int j = 0; j < G->n; j++) {
+    int d = membership[j];
+    const double* column = &G->adjacency[(size_t) j * G->n];
+    for(int i = 0; i < G->n; i++) {
+      if(column[i] != 0.0) {
+        W->buffer[membership[i] + (size_t) d * k] += column[i];
+      }
+    }
+  }
+
+  // Zero diagonal (constant within communities)
+  for(int c = 0; c < k; c++) {
+    W->buffer[c + (size_t) c * k] = 0.0;
+  }
+
+  // Sum node weights
+  for(int c = 0; c < k; c++) {
+    W->community_positive[c] = W->community_negative[c] = 0.0;
+  }
+  for(int i = 0; i < G->n; i++) {
+    W->community_positive[membership[i]] += G->positive[i];
+    W->community_negative[membership[i]] += G->negative[i];
+  }
+
+  // Set aggregated network
+  G->n = k;
+  memcpy(G->adjacency, W->buffer, (size_t) k * k * sizeof(double));
+  memcpy(G->positive, W->community_positive, k * sizeof(double));
+  memcpy(G->negative, W->community_negative, k * sizeof(double));
+
+}
+
+// Louvain-type search at one resolution
+// `initial` is the starting partition (NULL for singletons)
+static void louvain_search(
+    const path_graph* base, const path_objective* objective, double gamma,
+    const int* initial, int* output, path_workspace* W
+) {
+
+  // Copy network
+  int p = base->n;
+  path_graph* G = &W->graph;
+  G->n = p;
+  memcpy(G->adjacency, base->adjacency, (size_t) p * p * sizeof(double));
+  memcpy(G->positive, base->positive, p * sizeof(double));
+  memcpy(G->negative, base->negative, p * sizeof(double));
+
+  // Initialize partition
+  for(int i = 0; i < p; i++) {
+    W->node_map[i] = i;
+    W->membership[i] = (initial == NULL) ? i : initial[i];
+  }
+
+  // Levels of aggregation
+  for(int level = 0; ; level++) {
+
+    // Move nodes
+    int moves = local_moving(G, objective, gamma, W->membership, W);
+
+    // Check for no improvement (after warm start level)
+    if(level > 0 && moves == 0) {
+      break;
+    }
+
+    // Relabel communities
+    int k = relabel(W->membership, G->n, W->labels);
+
+    // Update original nodes
+    for(int i = 0; i < p; i++) {
+      W->node_map[i] = W->membership[W->node_map[i]];
+    }
+
+    // Check for no aggregation
+    if(k == G->n) {
+      break;
+    }
+
+    // Aggregate and start from singletons
+    aggregate(G, W->membership, k, W);
+    for(int c = 0; c < k; c++) {
+      W->membership[c] = c;
+    }
+
+  }
+
+  // Set output
+  memcpy(output, W->node_map, p * sizeof(int));
+  relabel(output, p, W->labels);
+
+}
+
+// Update lower bound with gain a - gamma * b
+// Returns 0 when the move improves at `gamma`
+static inline int update_bound(double a, double b, double gamma, double* lower) {
+
+  // Gain decreases with resolution (bound from below)
+  if(b > 0) {
+    double bound = (a - GAIN_TOLERANCE) / b;
+    if(bound > *lower) {
+      *lower = bound;
+    }
+    return bound <= gamma;
+  }
+
+  // Otherwise, must not improve at `gamma` (nor below)
+  return a - gamma * b <= GAIN_TOLERANCE;
+
+}
+
+// Smallest resolution (at or below `gamma`) at which a partition
+// has no improving node move or community merge
+// Returns `gamma` when the partition can improve at `gamma`
+static double stability_bound(
+    const path_graph* base, const path_objective* objective, double gamma,
+    const int* membership, path_workspace* W
+) {
+
+  // Initialize bound
+  int p = base->n;
+  double lower = R_NegInf;
+
+  // Community sums (`membership` is labeled 0 to k - 1)
+  community_sums(base, membership, W);
+  int k = 0;
+  for(int i = 0; i < p; i++) {
+    if(membership[i] >= k) {
+      k = membership[i] + 1;
+    }
+  }
+
+  // Node moves
+  for(int i = 0; i < p; i++) {
+
+    // Remove node
+    int c = membership[i];
+    double node_positive = base->positive[i], node_negative = base->negative[i];
+    double positive_c = W->community_positive[c] - node_positive;
+    double negative_c = W->community_negative[c] - node_negative;
+
+    // Weights to communities
+    int n_touched = neighbor_weights(base, membership, i, W);
+    double weight_c = W->neighbor_weight[c];
+
+    // Moves to other communities
+    int stable = 1;
+    for(int d = 0; d < k && stable; d++) {
+      if(d != c) {
+        stable = update_bound(
+          2 * (W->neighbor_weight[d] - weight_c),
+          penalty(objective, node_positive, node_negative, W->community_positive[d], W->community_negative[d]) -
+          penalty(objective, node_positive, node_negative, positive_c, negative_c),
+          gamma, &lower
+        );
+      }
+    }
+
+    // Move to empty community
+    if(stable && W->count[c] > 1) {
+      stable = update_bound(
+        -2 * weight_c,
+        -penalty(objective, node_positive, node_negative, positive_c, negative_c),
+        gamma, &lower
+      );
+    }
+
+    // Reset weights
+    for(int t = 0; t < n_touched; t++) {
+      W->neighbor_weight[W->touched[t]] = 0.0;
+    }
+
+    // Check for improvement
+    if(!stable) {
+      return gamma;
+    }
+
+  }
+
+  // Weights between communities
+  memset(W->buffer, 0, (size_t) k * k * sizeof(double));
+  for(int j = 0; j < p; j++) {
+    const double* column = &base->adjacency[(size_t) j * p];
+    for(int i = 0; i < p; i++) {
+      W->buffer[membership[i] + (size_t) membership[j] * k] += column[i];
+    }
+  }
+
+  // Community merges
+  for(int c = 0; c < k; c++) {
+    for(int d = c + 1; d < k; d++) {
+      if(
+        !update_bound(
+          2 * W->buffer[c + (size_t) d * k],
+          penalty(
+            objective, W->community_positive[c], W->community_negative[c],
+            W->community_positive[d], W->community_negative[d]
+          ), gamma, &lower
+        )
+      ) {
+        return gamma;
+      }
+    }
+  }
+
+  // Return bound
+  return lower;
+
+}
+
+// Order of resolutions (descending)
+static const double* sort_values;
+static int compare_descending(const void* a, const void* b) {
+  double x = sort_values[*(const int*) a], y = sort_values[*(const int*) b];
+  return (x < y) - (x > y);
+}
+
+// Interface with R
+// `r_network` is the (absolute) network; returns grid x nodes memberships
+SEXP r_resolution_path(SEXP r_network, SEXP r_resolution, SEXP r_cpm, SEXP r_ncores) {
+
+  // Get dimensions
+  int p = ncols(r_network);
+  int grid = length(r_resolution);
+  const double* resolution = REAL(r_resolution);
+  const double* network = REAL(r_network);
+  int cpm = LOGICAL(r_cpm)[0];
+
+  // Set up network (zero diagonal) and node weights
+  path_graph base;
+  base.n = p;
+  base.adjacency = (double*) R_alloc((size_t) p * p, sizeof(double));
+  base.positive = (double*) R_alloc(p > 0 ? p : 1, sizeof(double));
+  base.negative = (double*) R_alloc(p > 0 ? p : 1, sizeof(double));
+  path_objective objective = {0.0, 0.0};
+  double strength = 0.0;
+  for(int j = 0; j < p; j++) {
+    double positive = 0.0, negative = 0.0;
+    for(int i = 0; i < p; i++) {
+      double edge = (i == j || ISNAN(network[i + (size_t) j * p])) ?
+        0.0 : network[i + (size_t) j * p];
+      base.adjacency[i + (size_t) j * p] = edge;
+      if(edge > 0) {
+        positive += edge;
+      }else{
+        negative -= edge;
+      }
+    }
+    base.positive[j] = cpm ? 1.0 : positive;
+    base.negative[j] = cpm ? 0.0 : negative;
+    strength += positive;
+    objective.positive_total += base.positive[j];
+    objective.negative_total += base.negative[j];
+  }
+
+  // CPM penalty is not scaled (gamma * n_i * n_c)
+  if(cpm) {
+    objective.positive_total = 1.0;
+  }
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocMatrix(INTSXP, grid, p));
+  int* output = INTEGER(r_output);
+
+  // Check for edges
+  if(strength == 0) {
+    for(size_t k = 0; k < (size_t) grid * p; k++) {
+      output[k] = (int) (k / grid) + 1; // singletons
+    }
+    UNPROTECT(1);
+    return r_output;
+  }
+
+  // Order resolutions (descending)
+  int* order = (int*) R_alloc(grid > 0 ? grid : 1, sizeof(int));
+  for(int g = 0; g < grid; g++) {
+    order[g] = g;
+  }
+  sort_values = resolution;
+  qsort(order, grid, sizeof(int), compare_descending);
+
+  // Memberships of each grid point (0-based)
+  int* memberships = (int*) R_alloc((size_t) (grid > 0 ? grid : 1) * p, sizeof(int));
+
+  // Segments of grid
+  int segments = (grid + PATH_SEGMENT - 1) / PATH_SEGMENT;
+
+  #pragma omp parallel num_threads(INTEGER(r_ncores)[0])
+  {
+
+    // Per thread workspace
+    path_workspace W;
+    workspace_allocate(p > 0 ? p : 1, &W);
+
+    #pragma omp for schedule(dynamic)
+    for(int s = 0; s < segments; s++) {
+
+      // Initialize path
+      const int* previous = NULL;
+      double lower = R_PosInf;
+
+      // Sweep segment (descending resolutions)
+      int end = (s + 1) * PATH_SEGMENT < grid ? (s + 1) * PATH_SEGMENT : grid;
+      for(int t = s * PATH_SEGMENT; t < end; t++) {
+
+        // Get resolution and output
+        double gamma = resolution[order[t]];
+        int* current = &memberships[(size_t) order[t] * p];
+
+        // Check for unchanged partition
+        if(previous != NULL && gamma >= lower) {
+          memcpy(current, previous, p * sizeof(int));
+        }else{
+
+          // Search from previous partition
+          louvain_search(&base, &objective, gamma, previous, current, &W);
+
+          // Range with the same partition
+          lower = stability_bound(&base, &objective, gamma, current, &W);
+
+        }
+
+        // Update previous
+        previous = current;
+
+      }
+
+    }
+
+    // Free workspace
+    workspace_free(&W);
+
+  }
+
+  // Set output (1-based)
+  for(int g = 0; g < grid; g++) {
+    for(int i = 0; i < p; i++) {
+      output[g + (size_t) i * grid] = memberships[(size_t) g * p + i] + 1;
+    }
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
@@ -0,0 +1,439 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "bitset.h"
+
+/*
+
+ Batched Total Entropy Fit Index (TEFI)
+
+ TEFI for many partitions of the same (absolute) correlation matrix.
+ Each distinct variable set (communities and the set of variables
+ with non-missing memberships) is registered once in a hash table
+ keyed by its bitset, so the entropy of the full matrix and of
+ communities shared across partitions is computed only once.
+ Set entropies are then computed in parallel
+
+ The entropy of a set follows `matrix_entropy` in R: with
+ rho = R[set, set] / |set|, the diagonal of rho %*% log(rho) is
+ summed (element-wise log with base 2.718282); rows that are
+ `NaN` are dropped like `sum(..., na.rm = TRUE)`
+
+ Hierarchical structures (lower and higher order memberships)
+ follow `tefi_generalized`
+
+*/
+
+// Base used by `matrix_entropy`
+#define TEFI_BASE 2.718282
+
+// Registry of variable sets
+typedef struct {
+  int words;
+  int n_sets;
+  int capacity;
+  uint64_t* keys;
+  size_t table_size;
+  int* table;
+} set_registry;
+
+// FNV-1a (64-bit) over bitset words
+static inline uint64_t hash_set(const uint64_t* key, int words) {
+
+  // Initialize hash
+  uint64_t hash = 0xcbf29ce484222325ULL;
+
+  // Loop over words
+  for(int k = 0; k < words; k++) {
+    hash ^= key[k];
+    hash *= 0x100000001b3ULL;
+  }
+
+  // Return hash
+  return hash;
+
+}
+
+// Insert index into hash table
+static void registry_insert(set_registry* registry, int index) {
+
+  // Find empty slot (linear probing)
+  size_t slot = hash_set(
+    &registry->keys[(size_t) index * registry->words], registry->words
+  ) & (registry->table_size - 1);
+  while(registry->table[slot] != -1) {
+    slot = (slot + 1) & (registry->table_size - 1);
+  }
+
+  // Set index
+  registry->table[slot] = index;
+
+}
+
+// Register set (returns its index)
+static int registry_add(set_registry* registry, const uint64_t* key) {
+
+  // Initialize words
+  int words = registry->words;
+
+  // Find slot (linear probing)
+  size_t slot = hash_set(key, words) & (registry->table_size - 1);
+  while(registry->table[slot] != -1) {
+
+    // Check for same set
+    if(
+      !memcmp(
+        &registry->keys[(size_t) registry->table[slot] * words],
+        key, words * sizeof(uint64_t)
+      )
+    ) {
+      return registry->table[slot];
+    }
+
+    // Move to next slot
+    slot = (slot + 1) & (registry->table_size - 1);
+
+  }
+
+  // Grow keys
+  if(registry->n_sets == registry->capacity) {
+    registry->capacity *= 2;
+    registry->keys = (uint64_t*) realloc(
+      registry->keys, (size_t) registry->capacity * words * sizeof(uint64_t)
+    );
+  }
+
+  // Add key
+  int index = registry->n_sets++;
+  memcpy(&registry->keys[(size_t) index * words], key, words * sizeof(uint64_t));
+
+  // Grow table (keep load below one half)
+  if((size_t) registry->n_sets * 2 > registry->table_size) {
+
+    // Double size
+    registry->table_size *= 2;
+    registry->table = (int*) realloc(registry->table, registry->table_size * sizeof(int));
+    for(size_t k = 0; k < registry->table_size; k++) {
+      registry->table[k] = -1;
+    }
+
+    // Re-insert all sets
+    for(int k = 0; k < registry->n_sets; k++) {
+      registry_insert(registry, k);
+    }
+
+  }else{
+    registry->table[slot] = index;
+  }
+
+  // Return index
+  return index;
+
+}
+
+// Entropy of a variable set (same as `matrix_entropy`)
+static double set_entropy(
+    const double* correlation, int p, const uint64_t* key, int* members
+) {
+
+  // Obtain members
+  int m = 0;
+  for(int j = 0; j < p; j++) {
+    if(bitset_test(key, j)) {
+      members[m++] = j;
+    }
+  }
+
+  // Pre-compute log of base
+  double log_base = log(TEFI_BASE);
+
+  // Sum of diagonal (rows that are NaN are dropped)
+  long double total = 0.0L;
+  for(int i = 0; i < m; i++) {
+
+    // Row of rho * t(log(rho))
+    long double row = 0.0L;
+    for(int k = 0; k < m; k++) {
+      double value = correlation[members[i] + (size_t) members[k] * p] / m;
+      double transpose = correlation[members[k] + (size_t) members[i] * p] / m;
+      row += value * (log(transpose) / log_base);
+    }
+
+    // Add row
+    double row_sum = (double) row;
+    if(!isnan(row_sum)) {
+      total += row_sum;
+    }
+
+  }
+
+  // Return entropy
+  return -(double) total;
+
+}
+
+// Mean (same as R's `mean`)
+static double r_mean(const double* values, int n) {
+
+  // First pass
+  long double sum = 0.0L;
+  for(int i = 0; i < n; i++) {
+    sum += values[i];
+  }
+  sum /= n;
+
+  // Second pass (correction)
+  if(isfinite((double) sum)) {
+    long double correction = 0.0L;
+    for(int i = 0; i < n; i++) {
+      correction += values[i] - sum;
+    }
+    sum += correction / n;
+  }
+
+  // Return mean
+  return (double) sum;
+
+}
+
+// Register communities of one membership row
+// Returns the number of communities (same as `unique_length`)
+static int register_communities(
+    set_registry* registry, const int* membership, int candidates, int p,
+    const char* keep, uint64_t* key, int* labels, int* set_index
+) {
+
+  // Initialize communities
+  int communities = 0;
+
+  // Count unique labels among kept variables
+  for(int j = 0; j < p; j++) {
+
+    // Skip removed
+    if(!keep[j]) {
+      continue;
+    }
+
+    // Check for new label
+    int label = membership[(size_t) j * candidates];
+    int seen = 0;
+    for(int k = 0; k < communities; k++) {
+      if(labels[k] == label) {
+        seen = 1;
+        break;
+      }
+    }
+    if(!seen) {
+      labels[communities++] = label;
+    }
+
+  }
+
+  // Register community sets (labels 1 to communities like `tefi`)
+  for(int c = 1; c <= communities; c++) {
+
+    // Build key
+    memset(key, 0, registry->words * sizeof(uint64_t));
+    for(int j = 0; j < p; j++) {
+      if(keep[j] && membership[(size_t) j * candidates] == c) {
+        bitset_set(key, j);
+      }
+    }
+
+    // Register set
+    set_index[c - 1] = registry_add(registry, key);
+
+  }
+
+  // Return communities
+  return communities;
+
+}
+
+// Batched TEFI
+// `lower` (and `higher` when hierarchical, otherwise NULL) are
+// candidates x p memberships (column-major)
+void tefi_batch(
+    const double* correlation, int p,
+    const int* lower, const int* higher, int candidates,
+    int n_threads, double* output
+) {
+
+  // Initialize iterators
+  int i, j;
+
+  // Initialize registry
+  set_registry registry;
+  registry.words = BITSET_WORDS(p);
+  registry.n_sets = 0;
+  registry.capacity = 64;
+  registry.keys = (uint64_t*) malloc((size_t) registry.capacity * registry.words * sizeof(uint64_t));
+  registry.table_size = 128;
+  registry.table = (int*) malloc(registry.table_size * sizeof(int));
+  for(size_t k = 0; k < registry.table_size; k++) {
+    registry.table[k] = -1;
+  }
+
+  // Initialize memory
+  uint64_t* key = (uint64_t*) malloc(registry.words * sizeof(uint64_t));
+  char* keep = (char*) malloc(p * sizeof(char));
+  int* labels = (int*) malloc(p * sizeof(int));
+
+  // Sets for each candidate
+  int* total_set = (int*) malloc(candidates * sizeof(int));
+  int* lower_communities = (int*) malloc(candidates * sizeof(int));
+  int* higher_communities = (int*) calloc(candidates, sizeof(int));
+  int* lower_sets = (int*) malloc((size_t) candidates * p * sizeof(int));
+  int* higher_sets = (higher == NULL) ? NULL : (int*) malloc((size_t) candidates * p * sizeof(int));
+
+  // Register sets
+  for(i = 0; i < candidates; i++) {
+
+    // Kept variables (non-missing at every order)
+    memset(key, 0, registry.words * sizeof(uint64_t));
+    for(j = 0; j < p; j++) {
+      keep[j] = lower[i + (size_t) j * candidates] != NA_INTEGER &&
+        (higher == NULL || higher[i + (size_t) j * candidates] != NA_INTEGER);
+      if(keep[j]) {
+        bitset_set(key, j);
+      }
+    }
+
+    // Register total set
+    total_set[i] = registry_add(&registry, key);
+
+    // Register communities
+    lower_communities[i] = register_communities(
+      &registry, &lower[i], candidates, p, keep, key, labels,
+      &lower_sets[(size_t) i * p]
+    );
+    if(higher != NULL) {
+      higher_communities[i] = register_communities(
+        &registry, &higher[i], candidates, p, keep, key, labels,
+        &higher_sets[(size_t) i * p]
+      );
+    }
+
+  }
+
+  // Compute entropy of each set once
+  double* entropies = (double*) malloc(registry.n_sets * sizeof(double));
+
+  #pragma omp parallel num_threads(n_threads)
+  {
+
+    // Members of set (per thread)
+    int* members = (int*) malloc(p * sizeof(int));
+
+    #pragma omp for schedule(dynamic, 4)
+    for(int s = 0; s < registry.n_sets; s++) {
+      entropies[s] = set_entropy(
+        correlation, p, &registry.keys[(size_t) s * registry.words], members
+      );
+    }
+
+    // Free memory
+    free(members);
+
+  }
+
+  // Compute TEFI for each candidate
+  double* community_entropies = (double*) malloc(p * sizeof(double));
+
+  for(i = 0; i < candidates; i++) {
+
+    // Total entropy
+    double H_vn = entropies[total_set[i]];
+
+    // Lower order community entropies
+    int communities = lower_communities[i];
+    for(j = 0; j < communities; j++) {
+      community_entropies[j] = entropies[lower_sets[(size_t) i * p + j]];
+    }
+
+    // Check for hierarchical
+    if(higher == NULL) {
+
+      // Same as `tefi_standard`
+      double mean_H_vn_wc = r_mean(community_entropies, communities);
+      double sum_H_vn_wc = mean_H_vn_wc * communities;
+      double mean_H_vn = mean_H_vn_wc - H_vn;
+
+      output[i] = mean_H_vn + ((H_vn - sum_H_vn_wc) * sqrt((double) communities));
+      output[i + candidates] = sum_H_vn_wc - H_vn;
+      output[i + 2 * candidates] = mean_H_vn;
+
+    }else{
+
+      // Same as `tefi_generalized`
+      long double A = 0.0L, E = 0.0L;
+      for(j = 0; j < communities; j++) {
+        A += community_entropies[j];
+      }
+      for(j = 0; j < higher_communities[i]; j++) {
+        E += entropies[higher_sets[(size_t) i * p + j]];
+      }
+
+      double sum_lower = (double) A, sum_higher = (double) E;
+      double sqrt_lower = sqrt((double) communities);
+      double double_H_vn = 2 * H_vn;
+
+      output[i] = ((sum_lower + sum_higher) / communities) - double_H_vn +
+        (double_H_vn - sum_lower - sum_higher) * sqrt_lower;
+      output[i + candidates] = (sum_lower / communities - H_vn) + (H_vn - sum_lower) * sqrt_lower;
+      output[i + 2 * candidates] = (sum_higher / communities - H_vn) + (H_vn - sum_higher) * sqrt_lower;
+
+    }
+
+  }
+
+  // Free memory
+  free(registry.keys);
+  free(registry.table);
+  free(key);
+  free(keep);
+  free(labels);
+  free(total_set);
+  free(lower_communities);
+  free(higher_communities);
+  free(lower_sets);
+  free(higher_sets);
+  free(entropies);
+  free(community_entropies);
+
+}
+
+// Interface with R
+SEXP r_tefi_batch(
+    SEXP r_correlation, SEXP r_lower, SEXP r_higher, SEXP r_ncores
+) {
+
+  // Get dimensions
+  int p = ncols(r_correlation);
+  int candidates = nrows(r_lower);
+
+  // Check dimensions
+  if(ncols(r_lower) != p || (!isNull(r_higher) && ncols(r_higher) != p)) {
+    Rf_error("Memberships must have the same number of variables as the correlation matrix. Terminating...");
+  }
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocMatrix(REALSXP, candidates, 3));
+
+  // Call the C function
+  tefi_batch(
+    REAL(r_correlation), p,
+    INTEGER(r_lower), isNull(r_higher) ? NULL : INTEGER(r_higher),
+    candidates, INTEGER(r_ncores)[0], REAL(r_output)
+  );
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
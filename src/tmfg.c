@@ -0,0 +1,643 @@
+#include <math.h>
+#include <stdlib.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Triangulated Maximally Filtered Graph (TMFG)
+
+ Each triangle (face) keeps its best candidate: the remaining node
+ with the largest sum of absolute correlations to the triangle's
+ three vertices. Candidates are kept in a max-heap ordered by gain
+ (ties go to the lowest triangle index) and only the three triangles
+ created at each insertion are recomputed. Entries whose candidate
+ was inserted elsewhere are recomputed lazily when they reach the top
+
+ Tie-breaking is identical to `TMFG` in R: among equal gains, the
+ lowest triangle index wins and then the lowest node index
+
+ Gains are accumulated in `long double` in the triangle's vertex
+ order to match `rowSums(..., na.rm = TRUE)`
+
+*/
+
+// Heap entry
+struct tmfg_entry {
+  double gain;
+  int triangle;
+  int node;
+  int version;
+};
+
+// Heap
+struct tmfg_heap {
+  struct tmfg_entry* entries;
+  int size;
+  int capacity;
+};
+
+// Compare entries (1 when `a` comes before `b`)
+static inline int entry_before(const struct tmfg_entry* a, const struct tmfg_entry* b) {
+  return a->gain > b->gain || (a->gain == b->gain && a->triangle < b->triangle);
+}
+
+// Push entry onto heap
+static void heap_push(struct tmfg_heap* heap, struct tmfg_entry entry) {
+
+  // Grow heap
+  if(heap->size == heap->capacity) {
+    heap->capacity *= 2;
+    heap->entries = (struct tmfg_entry*) realloc(
+      heap->entries, heap->capacity * sizeof(struct tmfg_entry)
+    );
+  }
+
+  // Sift up
+  int i = heap->size++;
+  while(i > 0) {
+    int parent = (i - 1) / 2;
+    if(!entry_before(&entry, &heap->entries[parent])) {
+      break;
+    }
+    heap->entries[i] = heap->entries[parent];
+    i = parent;
+  }
+  heap->entries[i] = entry;
+
+}
+
+// Pop top entry from heap
+static struct tmfg_entry heap_pop(struct tmfg_heap* heap) {
+
+  // Get top
+  struct tmfg_entry top = heap->entries[0];
+
+  // Move last entry to top and sift down
+  struct tmfg_entry last = heap->entries[--heap->size];
+  int i = 0;
+  while(1) {
+    int child = 2 * i + 1;
+    if(child >= heap->size) {
+      break;
+    }
+    if(child + 1 < heap->size && entry_before(&heap->entries[child + 1], &heap->entries[child])) {
+      child++;
+    }
+    if(!entry_before(&heap->entries[child], &last)) {
+      break;
+    }
+    heap->entries[i] = heap->entries[child];
+    i = child;
+  }
+  if(heap->size > 0) {
+    heap->entries[i] = last;
+  }
+
+  // Return top
+  return top;
+
+}
+
+// Gain of a node for a triangle
+static inline double triangle_gain(const double* absolute, int nodes, int node, const int* triangle) {
+
+  // Initialize sum
+  long double sum = 0.0;
+
+  // Loop over vertices
+  for(int k = 0; k < 3; k++) {
+    double value = absolute[node + (size_t) triangle[k] * nodes];
+    if(!isnan(value)) {
+      sum += value;
+    }
+  }
+
+  // Return gain
+  return (double) sum;
+
+}
+
+// Compute best candidate for a triangle and push onto heap
+static void best_candidate(
+    struct tmfg_heap* heap, const double* absolute, int nodes,
+    const int* remaining, const int* triangles, int triangle, int version
+) {
+
+  // Initialize best
+  struct tmfg_entry entry = {-INFINITY, triangle, -1, version};
+
+  // Loop over remaining nodes (ascending)
+  for(int node = 0; node < nodes; node++) {
+
+    // Skip inserted
+    if(!remaining[node]) {
+      continue;
+    }
+
+    // Compute gain
+    double gain = triangle_gain(absolute, nodes, node, &triangles[triangle * 3]);
+
+    // Update best (strictly greater keeps lowest node)
+    if(gain > entry.gain || entry.node == -1) {
+      entry.gain = gain;
+      entry.node = node;
+    }
+
+  }
+
+  // Push entry
+  heap_push(heap, entry);
+
+}
+
+// Construct TMFG
+// `first_four` are zero-indexed
+// `separators` is (nodes - 4) x 3 and `inserted` is nodes (zero-indexed)
+void tmfg(
+    const double* correlation, int nodes, const int* first_four,
+    double* network, int* separators, int* inserted
+) {
+
+  // Initialize iterators
+  int i, j, k;
+
+  // Absolute correlations
+  double* absolute = (double*) malloc((size_t) nodes * nodes * sizeof(double));
+  for(i = 0; i < nodes * nodes; i++) {
+    absolute[i] = fabs(correlation[i]);
+  }
+
+  // Remaining nodes
+  int* remaining = (int*) malloc(nodes * sizeof(int));
+  for(i = 0; i < nodes; i++) {
+    remaining[i] = 1;
+  }
+
+  // Initialize network (identity)
+  for(i = 0; i < nodes * nodes; i++) {
+    network[i] = 0.0;
+  }
+  for(i = 0; i < nodes; i++) {
+    network[i + (size_t) i * nodes] = 1.0;
+  }
+
+  // Insert first four
+  for(i = 0; i < 4; i++) {
+    inserted[i] = first_four[i];
+    remaining[first_four[i]] = 0;
+  }
+
+  // Add first four to network
+  for(i = 0; i < 4; i++) {
+    for(j = 0; j < 4; j++) {
+      network[first_four[i] + (size_t) first_four[j] * nodes] =
+        correlation[first_four[i] + (size_t) first_four[j] * nodes];
+    }
+  }
+
+  // Initialize triangles (2 * nodes - 4 triangles x 3 vertices)
+  int triangle_total = 2 * nodes - 4;
+  int* triangles = (int*) malloc(triangle_total * 3 * sizeof(int));
+  int* versions = (int*) calloc(triangle_total, sizeof(int));
+
+  // Build tetrahedron (each triangle drops one of the first four)
+  for(i = 0; i < 4; i++) {
+    k = 0;
+    for(j = 0; j < 4; j++) {
+      if(j != i) {
+        triangles[i * 3 + k++] = first_four[j];
+      }
+    }
+  }
+
+  // Initialize heap
+  struct tmfg_heap heap;
+  heap.capacity = 2 * triangle_total + 16;
+  heap.size = 0;
+  heap.entries = (struct tmfg_entry*) malloc(heap.capacity * sizeof(struct tmfg_entry));
+
+  // Initial gains
+  for(i = 0; i < 4; i++) {
+    best_candidate(&heap, absolute, nodes, remaining, triangles, i, versions[i]);
+  }
+
+  // Number of triangles
+  int triangle_count = 4;
+
+  // Loop over remaining nodes
+  for(i = 4; i < nodes; i++) {
+
+    // Find best (valid) entry
+    struct tmfg_entry top;
+
+    while(1) {
+
+      // Get top
+      top = heap_pop(&heap);
+
+      // Skip outdated triangles
+      if(top.version != versions[top.triangle]) {
+        continue;
+      }
+
+      // Recompute when candidate was inserted elsewhere
+      if(!remaining[top.node]) {
+        best_candidate(&heap, absolute, nodes, remaining, triangles, top.triangle, top.version);
+        continue;
+      }
+
+      // Valid entry
+      break;
+
+    }
+
+    // Get vertices
+    int max_gain = top.triangle;
+    int add_vertex = top.node;
+    int* triangle = &triangles[max_gain * 3];
+    int a = triangle[0], b = triangle[1], c = triangle[2];
+
+    // Update lists
+    remaining[add_vertex] = 0;
+    inserted[i] = add_vertex;
+
+    // Add edges to network
+    for(k = 0; k < 3; k++) {
+      network[add_vertex + (size_t) triangle[k] * nodes] =
+        network[triangle[k] + (size_t) add_vertex * nodes] =
+        correlation[add_vertex + (size_t) triangle[k] * nodes];
+    }
+
+    // Update separators (column-major)
+    separators[(i - 4)] = a;
+    separators[(i - 4) + (nodes - 4)] = b;
+    separators[(i - 4) + 2 * (nodes - 4)] = c;
+
+    // Update triangles list
+    // Add two triangles
+    triangles[triangle_count * 3] = a;
+    triangles[triangle_count * 3 + 1] = c;
+    triangles[triangle_count * 3 + 2] = add_vertex;
+    triangles[(triangle_count + 1) * 3] = b;
+    triangles[(triangle_count + 1) * 3 + 1] = c;
+    triangles[(triangle_count + 1) * 3 + 2] = add_vertex;
+    // Replace maximum gain triangle (no longer a triangle)
+    triangle[2] = add_vertex;
+    versions[max_gain]++;
+
+    // Check for remaining nodes
+    if(i == nodes - 1) {
+      break;
+    }
+
+    // Update gains
+    best_candidate(&heap, absolute, nodes, remaining, triangles, max_gain, versions[max_gain]);
+    best_candidate(&heap, absolute, nodes, remaining, triangles, triangle_count, versions[triangle_count]);
+    best_candidate(&heap, absolute, nodes, remaining, triangles, triangle_count + 1, versions[triangle_count + 1]);
+
+    // Update triangle count
+    triangle_count += 2;
+
+  }
+
+  // Free memory
+  free(absolute);
+  free(remaining);
+  free(triangles);
+  free(versions);
+  free(heap.entries);
+
+}
+
+// Interface with R
+SEXP r_tmfg(SEXP r_correlation, SEXP r_first_four) {
+
+  // Get nodes
+  int nodes = ncols(r_correlation);
+
+  // Check nodes
+  if(nodes < 4) {
+    Rf_error("TMFG requires at least 4 nodes. Terminating...");
+  }
+
+  // First four (zero-indexed)
+  int first_four[4];
+  for(int i = 0; i < 4; i++) {
+    first_four[i] = INTEGER(r_first_four)[i] - 1;
+  }
+
+  // Initialize R results
+  SEXP r_network = PROTECT(allocMatrix(REALSXP, nodes, nodes));
+  SEXP r_separators = PROTECT(allocMatrix(INTSXP, nodes - 4, 3));
+  SEXP r_cliques = PROTECT(allocMatrix(INTSXP, nodes - 3, 4));
+
+  // Initialize inserted
+  int* inserted = (int*) R_alloc(nodes, sizeof(int));
+
+  // Call the C function
+  tmfg(
+    REAL(r_correlation), nodes, first_four,
+    REAL(r_network), INTEGER(r_separators), inserted
+  );
+
+  // Get pointers
+  int* c_separators = INTEGER(r_separators);
+  int* c_cliques = INTEGER(r_cliques);
+  int separator_rows = nodes - 4;
+  int clique_rows = nodes - 3;
+
+  // Set up cliques (first four, then separators with inserted node)
+  for(int k = 0; k < 4; k++) {
+    c_cliques[k * clique_rows] = inserted[k] + 1;
+  }
+  for(int i = 0; i < separator_rows; i++) {
+    for(int k = 0; k < 3; k++) {
+      c_separators[i + k * separator_rows]++; // 1-based
+      c_cliques[(i + 1) + k * clique_rows] = c_separators[i + k * separator_rows];
+    }
+    c_cliques[(i + 1) + 3 * clique_rows] = inserted[i + 4] + 1;
+  }
+
+  // Set up result list
+  SEXP r_result = PROTECT(allocVector(VECSXP, 3));
+  SET_VECTOR_ELT(r_result, 0, r_network);
+  SET_VECTOR_ELT(r_result, 1, r_separators);
+  SET_VECTOR_ELT(r_result, 2, r_cliques);
+
+  // Set names
+  SEXP r_names = PROTECT(allocVector(STRSXP, 3));
+  SET_STRING_ELT(r_names, 0, mkChar("network"));
+  SET_STRING_ELT(r_names, 1, mkChar("separators"));
+  SET_STRING_ELT(r_names, 2, mkChar("cliques"));
+  setAttrib(r_result, R_NamesSymbol, r_names);
+
+  // Release protected SEXP objects
+  UNPROTECT(5);
+
+  // Return result
+  return r_result;
+
+}
+
+/*
+
+ Local-Global (LoGo) inversion for TMFG (Barfuss et al., 2016)
+
+ The precision matrix is the sum of the inverses of the 4-node
+ cliques minus the sum of the inverses of the 3-node separators.
+ Each block is inverted in closed form (adjugate over determinant)
+ and accumulated only over the 3p - 6 TMFG edges and the diagonal,
+ so there is no dense precision matrix or `solve` per block
+
+ The partial correlation network (-cov2cor(precision) with zero
+ diagonal) is written directly into the output
+
+*/
+
+// Invert symmetric 3 x 3 matrix in closed form
+static inline int invert3(const double* m, double* inverse) {
+
+  // Cofactors
+  inverse[0] = m[4] * m[8] - m[5] * m[7];
+  inverse[1] = m[2] * m[7] - m[1] * m[8];
+  inverse[2] = m[1] * m[5] - m[2] * m[4];
+  inverse[4] = m[0] * m[8] - m[2] * m[6];
+  inverse[5] = m[2] * m[3] - m[0] * m[5];
+  inverse[8] = m[0] * m[4] - m[1] * m[3];
+
+  // Determinant
+  double determinant = m[0] * inverse[0] + m[3] * inverse[1] + m[6] * inverse[2];
+
+  // Check for singular matrix
+  if(determinant == 0.0 || isnan(determinant)) {
+    return 0;
+  }
+
+  // Scale (upper triangle and mirror)
+  double scale = 1.0 / determinant;
+  inverse[0] *= scale; inverse[1] *= scale; inverse[2] *= scale;
+  inverse[4] *= scale; inverse[5] *= scale; inverse[8] *= scale;
+  inverse[3] = inverse[1]; inverse[6] = inverse[2]; inverse[7] = inverse[5];
+
+  // Success
+  return 1;
+
+}
+
+// Invert 4 x 4 matrix in closed form (cofactor expansion)
+static inline int invert4(const double* m, double* inverse) {
+
+  // 2 x 2 sub-determinants
+  double s0 = m[0] * m[5] - m[4] * m[1];
+  double s1 = m[0] * m[6] - m[4] * m[2];
+  double s2 = m[0] * m[7] - m[4] * m[3];
+  double s3 = m[1] * m[6] - m[5] * m[2];
+  double s4 = m[1] * m[7] - m[5] * m[3];
+  double s5 = m[2] * m[7] - m[6] * m[3];
+
+  double c5 = m[10] * m[15] - m[14] * m[11];
+  double c4 = m[9] * m[15] - m[13] * m[11];
+  double c3 = m[9] * m[14] - m[13] * m[10];
+  double c2 = m[8] * m[15] - m[12] * m[11];
+  double c1 = m[8] * m[14] - m[12] * m[10];
+  double c0 = m[8] * m[13] - m[12] * m[9];
+
+  // Determinant
+  double determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+  // Check for singular matrix
+  if(determinant == 0.0 || isnan(determinant)) {
+    return 0;
+  }
+
+  // Scale
+  double scale = 1.0 / determinant;
+
+  // Adjugate
+  inverse[0] = ( m[5] * c5 - m[6] * c4 + m[7] * c3) * scale;
+  inverse[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * scale;
+  inverse[2] = ( m[13] * s5 - m[14] * s4 + m[15] * s3) * scale;
+  inverse[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * scale;
+
+  inverse[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * scale;
+  inverse[5] = ( m[0] * c5 - m[2] * c2 + m[3] * c1) * scale;
+  inverse[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * scale;
+  inverse[7] = ( m[8] * s5 - m[10] * s2 + m[11] * s1) * scale;
+
+  inverse[8] = ( m[4] * c4 - m[5] * c2 + m[7] * c0) * scale;
+  inverse[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * scale;
+  inverse[10] = ( m[12] * s4 - m[13] * s2 + m[15] * s0) * scale;
+  inverse[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * scale;
+
+  inverse[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * scale;
+  inverse[13] = ( m[0] * c3 - m[1] * c1 + m[2] * c0) * scale;
+  inverse[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * scale;
+  inverse[15] = ( m[8] * s3 - m[9] * s1 + m[10] * s0) * scale;
+
+  // Success
+  return 1;
+
+}
+
+// Accumulate block inverse into precision (diagonal and edges)
+static inline int accumulate_block(
+    const double* correlation, int nodes, const int* block, int size,
+    double sign, double* diagonal, double* network
+) {
+
+  // Initialize block and inverse
+  double m[16], inverse[16];
+  int i, j;
+
+  // Obtain block
+  for(i = 0; i < size; i++) {
+    for(j = 0; j < size; j++) {
+      m[i + j * size] = correlation[block[i] + (size_t) block[j] * nodes];
+    }
+  }
+
+  // Invert block
+  int success = (size == 4) ? invert4(m, inverse) : invert3(m, inverse);
+
+  // Check for singular block
+  if(!success) {
+    return 0;
+  }
+
+  // Accumulate
+  for(i = 0; i < size; i++) {
+
+    // Diagonal
+    diagonal[block[i]] += sign * inverse[i + i * size];
+
+    // Off-diagonal (both triangles)
+    for(j = i + 1; j < size; j++) {
+      network[block[i] + (size_t) block[j] * nodes] += sign * inverse[i + j * size];
+      network[block[j] + (size_t) block[i] * nodes] += sign * inverse[j + i * size];
+    }
+
+  }
+
+  // Success
+  return 1;
+
+}
+
+// Scale edge into partial correlation
+static inline void partial_edge(double* network, const double* diagonal, int nodes, int i, int j) {
+  double value = -network[i + (size_t) j * nodes] / sqrt(diagonal[i] * diagonal[j]);
+  network[i + (size_t) j * nodes] = network[j + (size_t) i * nodes] = value;
+}
+
+// LoGo partial correlation network (returns 0 when a block is singular)
+// `cliques` is (nodes - 3) x 4 and `separators` is (nodes - 4) x 3 (zero-indexed, column-major)
+int tmfg_logo(
+    const double* correlation, int nodes,
+    const int* cliques, const int* separators,
+    double* network
+) {
+
+  // Initialize iterators
+  int i, k;
+  int clique_rows = nodes - 3, separator_rows = nodes - 4;
+  int block[4];
+
+  // Initialize diagonal
+  double* diagonal = (double*) calloc(nodes, sizeof(double));
+
+  // Initialize network
+  for(i = 0; i < nodes * nodes; i++) {
+    network[i] = 0.0;
+  }
+
+  // Add cliques
+  for(i = 0; i < clique_rows; i++) {
+    for(k = 0; k < 4; k++) {
+      block[k] = cliques[i + k * clique_rows];
+    }
+    if(!accumulate_block(correlation, nodes, block, 4, 1.0, diagonal, network)) {
+      free(diagonal);
+      return 0;
+    }
+  }
+
+  // Subtract separators
+  for(i = 0; i < separator_rows; i++) {
+    for(k = 0; k < 3; k++) {
+      block[k] = separators[i + k * separator_rows];
+    }
+    if(!accumulate_block(correlation, nodes, block, 3, -1.0, diagonal, network)) {
+      free(diagonal);
+      return 0;
+    }
+  }
+
+  // Convert edges to partial correlations
+  // First clique (6 edges)
+  for(i = 0; i < 4; i++) {
+    for(k = i + 1; k < 4; k++) {
+      partial_edge(
+        network, diagonal, nodes,
+        cliques[i * clique_rows], cliques[k * clique_rows]
+      );
+    }
+  }
+  // Inserted nodes (3 edges each)
+  for(i = 1; i < clique_rows; i++) {
+    for(k = 0; k < 3; k++) {
+      partial_edge(
+        network, diagonal, nodes,
+        cliques[i + 3 * clique_rows], cliques[i + k * clique_rows]
+      );
+    }
+  }
+
+  // Free memory
+  free(diagonal);
+
+  // Success
+  return 1;
+
+}
+
+// Interface with R
+SEXP r_tmfg_logo(SEXP r_correlation, SEXP r_cliques, SEXP r_separators) {
+
+  // Get nodes
+  int nodes = ncols(r_correlation);
+
+  // Zero-index cliques and separators
+  int clique_length = length(r_cliques);
+  int separator_length = length(r_separators);
+  int* cliques = (int*) R_alloc(clique_length, sizeof(int));
+  int* separators = (int*) R_alloc(separator_length, sizeof(int));
+  for(int i = 0; i < clique_length; i++) {
+    cliques[i] = INTEGER(r_cliques)[i] - 1;
+  }
+  for(int i = 0; i < separator_length; i++) {
+    separators[i] = INTEGER(r_separators)[i] - 1;
+  }
+
+  // Initialize R result
+  SEXP r_network = PROTECT(allocMatrix(REALSXP, nodes, nodes));
+
+  // Call the C function
+  int success = tmfg_logo(
+    REAL(r_correlation), nodes,
+    cliques, separators, REAL(r_network)
+  );
+
+  // Check for singular blocks
+  if(!success) {
+    UNPROTECT(1);
+    Rf_error("A TMFG clique or separator correlation matrix is singular. Terminating...");
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_network;
+
+}
@@ -0,0 +1,392 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+
+ Incremental weighted topological overlap
+
+ Keeps the numerator (crossprod(W) + W) and node strengths of a
+ (symmetric) network so that, when nodes are removed or inserted or
+ edges change between reduction passes, only the pairs in the
+ changed neighborhoods are updated:
+
+ Changing W[k, b] by delta changes crossprod(W)[b, j] by
+ delta * W[k, j] for the neighbors j of k (and [b, b] by
+ new^2 - old^2), W[k, b] itself and the strength of b
+
+ The overlap matrix is then one division per pair (O(p^2)) rather
+ than a new cross-product (O(p^3))
+
+ Nodes live in slots (assigned in R); slots of removed nodes are
+ re-used and the capacity grows when needed
+
+*/
+
+// Tracker
+typedef struct {
+
+  // Slots
+  int capacity;
+  int signed_network;
+  char* active;
+
+  // Network, numerator and strengths
+  double* value;
+  double* numerator;
+  double* strength;
+
+  // Neighbors (non-zero elements of each row)
+  int** neighbors;
+  int* degree;
+  int* neighbor_capacity;
+
+} wto_tracker;
+
+// Dense index
+#define TRACKER_INDEX(T, i, j) ((i) + (size_t) (j) * (T)->capacity)
+
+// Grow dense matrix to new capacity
+static void* grow_matrix(void* old, int old_capacity, int capacity, size_t size) {
+
+  // Allocate new matrix
+  char* matrix = (char*) calloc((size_t) capacity * capacity, size);
+
+  // Copy columns
+  for(int j = 0; j < old_capacity; j++) {
+    memcpy(
+      &matrix[(size_t) j * capacity * size],
+      &((char*) old)[(size_t) j * old_capacity * size],
+      (size_t) old_capacity * size
+    );
+  }
+
+  // Free old matrix
+  free(old);
+
+  // Return new matrix
+  return matrix;
+
+}
+
+// Grow vector to new capacity (new elements are zero)
+static void* grow_vector(void* old, int old_capacity, int capacity, size_t size) {
+
+  // Re-allocate
+  char* vector = (char*) realloc(old, (size_t) capacity * size);
+
+  // Set new elements to zero
+  memset(&vector[(size_t) old_capacity * size], 0, (size_t) (capacity - old_capacity) * size);
+
+  // Return vector
+  return vector;
+
+}
+
+// Ensure capacity
+static void tracker_reserve(wto_tracker* T, int capacity) {
+
+  // Check for sufficient capacity
+  if(capacity <= T->capacity) {
+    return;
+  }
+
+  // Double capacity (at least)
+  int old = T->capacity;
+  if(capacity < 2 * old) {
+    capacity = 2 * old;
+  }
+
+  // Grow matrices
+  T->value = (double*) grow_matrix(T->value, old, capacity, sizeof(double));
+  T->numerator = (double*) grow_matrix(T->numerator, old, capacity, sizeof(double));
+
+  // Grow vectors
+  T->active = (char*) grow_vector(T->active, old, capacity, sizeof(char));
+  T->strength = (double*) grow_vector(T->strength, old, capacity, sizeof(double));
+  T->neighbors = (int**) grow_vector(T->neighbors, old, capacity, sizeof(int*));
+  T->degree = (int*) grow_vector(T->degree, old, capacity, sizeof(int));
+  T->neighbor_capacity = (int*) grow_vector(T->neighbor_capacity, old, capacity, sizeof(int));
+
+  // Set capacity
+  T->capacity = capacity;
+
+}
+
+// Initialize tracker
+static wto_tracker* tracker_create(int capacity, int signed_network) {
+
+  // Allocate tracker
+  wto_tracker* T = (wto_tracker*) calloc(1, sizeof(wto_tracker));
+  T->signed_network = signed_network;
+
+  // Initialize slots (grown from one)
+  T->capacity = 1;
+  T->value = (double*) calloc(1, sizeof(double));
+  T->numerator = (double*) calloc(1, sizeof(double));
+  T->active = (char*) calloc(1, sizeof(char));
+  T->strength = (double*) calloc(1, sizeof(double));
+  T->neighbors = (int**) calloc(1, sizeof(int*));
+  T->degree = (int*) calloc(1, sizeof(int));
+  T->neighbor_capacity = (int*) calloc(1, sizeof(int));
+  tracker_reserve(T, capacity);
+
+  // Return tracker
+  return T;
+
+}
+
+// Free tracker
+static void tracker_free(wto_tracker* T) {
+
+  // Free neighbors
+  for(int k = 0; k < T->capacity; k++) {
+    free(T->neighbors[k]);
+  }
+
+  // Free memory
+  free(T->active);
+  free(T->value);
+  free(T->numerator);
+  free(T->strength);
+  free(T->neighbors);
+  free(T->degree);
+  free(T->neighbor_capacity);
+  free(T);
+
+}
+
+// Add neighbor `b` to row `k`
+static void add_neighbor(wto_tracker* T, int k, int b) {
+
+  // Grow neighbors
+  if(T->degree[k] == T->neighbor_capacity[k]) {
+    T->neighbor_capacity[k] = (T->neighbor_capacity[k] == 0) ? 8 : 2 * T->neighbor_capacity[k];
+    T->neighbors[k] = (int*) realloc(T->neighbors[k], T->neighbor_capacity[k] * sizeof(int));
+  }
+
+  // Add neighbor
+  T->neighbors[k][T->degree[k]++] = b;
+
+}
+
+// Remove neighbor `b` from row `k` (swap with last)
+static void remove_neighbor(wto_tracker* T, int k, int b) {
+  for(int a = 0; a < T->degree[k]; a++) {
+    if(T->neighbors[k][a] == b) {
+      T->neighbors[k][a] = T->neighbors[k][--T->degree[k]];
+      return;
+    }
+  }
+}
+
+// Set W[k, b] and update numerator and strength
+static void set_entry(wto_tracker* T, int k, int b, double new_value) {
+
+  // Use absolute values for unsigned
+  if(!T->signed_network) {
+    new_value = fabs(new_value);
+  }
+
+  // Check for change
+  size_t index = TRACKER_INDEX(T, k, b);
+  double old_value = T->value[index];
+  if(old_value == new_value) {
+    return;
+  }
+  double delta = new_value - old_value;
+
+  // Shared neighbors through row `k`
+  for(int a = 0; a < T->degree[k]; a++) {
+    int j = T->neighbors[k][a];
+    if(j != b) {
+      double product = delta * T->value[TRACKER_INDEX(T, k, j)];
+      T->numerator[TRACKER_INDEX(T, b, j)] += product;
+      T->numerator[TRACKER_INDEX(T, j, b)] += product;
+    }
+  }
+  T->numerator[TRACKER_INDEX(T, b, b)] += new_value * new_value - old_value * old_value;
+
+  // Edge itself
+  T->numerator[index] += delta;
+
+  // Strength (column sums)
+  T->strength[b] += fabs(new_value) - fabs(old_value);
+
+  // Update neighbors
+  if(old_value == 0.0) {
+    add_neighbor(T, k, b);
+  }else if(new_value == 0.0) {
+    remove_neighbor(T, k, b);
+  }
+
+  // Set value
+  T->value[index] = new_value;
+
+}
+
+// Overlap of a pair
+static inline double pair_wto(const wto_tracker* T, int i, int j) {
+
+  // Denominator
+  double minimum = (T->strength[i] < T->strength[j]) ? T->strength[i] : T->strength[j];
+
+  // Return overlap
+  return T->numerator[TRACKER_INDEX(T, i, j)] /
+    (minimum + 1 - fabs(T->value[TRACKER_INDEX(T, i, j)]));
+
+}
+
+// Remove node
+static void tracker_remove(wto_tracker* T, int x) {
+
+  // Remove edges (copy neighbors; the list changes)
+  int degree = T->degree[x];
+  int* neighbors = (int*) malloc((degree + 1) * sizeof(int));
+  memcpy(neighbors, T->neighbors[x], degree * sizeof(int));
+  for(int a = 0; a < degree; a++) {
+    set_entry(T, x, neighbors[a], 0.0);
+    if(neighbors[a] != x) {
+      set_entry(T, neighbors[a], x, 0.0);
+    }
+  }
+  free(neighbors);
+
+  // Clear numerator and strength (removes rounding residue)
+  for(int j = 0; j < T->capacity; j++) {
+    T->numerator[TRACKER_INDEX(T, x, j)] = 0.0;
+    T->numerator[TRACKER_INDEX(T, j, x)] = 0.0;
+  }
+  T->strength[x] = 0.0;
+
+  // Deactivate
+  T->active[x] = 0;
+
+}
+
+// Finalizer for R
+static void tracker_finalizer(SEXP r_pointer) {
+
+  // Get tracker
+  wto_tracker* T = (wto_tracker*) R_ExternalPtrAddr(r_pointer);
+
+  // Free tracker
+  if(T != NULL) {
+    tracker_free(T);
+    R_ClearExternalPtr(r_pointer);
+  }
+
+}
+
+// Get tracker from R
+static wto_tracker* get_tracker(SEXP r_pointer) {
+
+  // Get tracker
+  wto_tracker* T = (wto_tracker*) R_ExternalPtrAddr(r_pointer);
+
+  // Check for tracker
+  if(T == NULL) {
+    Rf_error("The wTO tracker is no longer available. Terminating...");
+  }
+
+  // Return tracker
+  return T;
+
+}
+
+// Interface with R (create tracker)
+SEXP r_wto_tracker(SEXP r_signed) {
+
+  // Create tracker
+  wto_tracker* T = tracker_create(64, LOGICAL(r_signed)[0]);
+
+  // Set up R result
+  SEXP r_pointer = PROTECT(R_MakeExternalPtr(T, R_NilValue, R_NilValue));
+  R_RegisterCFinalizerEx(r_pointer, tracker_finalizer, TRUE);
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_pointer;
+
+}
+
+// Interface with R (update tracker)
+// `r_remove` are slots of removed nodes; `r_slots` are the slots
+// of the network's nodes (new nodes are inserted); all are 0-based
+SEXP r_wto_tracker_update(
+    SEXP r_pointer, SEXP r_remove, SEXP r_slots, SEXP r_network
+) {
+
+  // Get tracker
+  wto_tracker* T = get_tracker(r_pointer);
+
+  // Get dimensions
+  int p = ncols(r_network);
+  int* slots = INTEGER(r_slots);
+  int* remove = INTEGER(r_remove);
+  const double* network = REAL(r_network);
+
+  // Remove nodes
+  for(int r = 0; r < length(r_remove); r++) {
+    if(remove[r] < T->capacity && T->active[remove[r]]) {
+      tracker_remove(T, remove[r]);
+    }
+  }
+
+  // Insert nodes
+  int maximum = 0;
+  for(int i = 0; i < p; i++) {
+    if(slots[i] >= maximum) {
+      maximum = slots[i] + 1;
+    }
+  }
+  tracker_reserve(T, maximum);
+  for(int i = 0; i < p; i++) {
+    T->active[slots[i]] = 1;
+  }
+
+  // Update changed edges
+  for(int j = 0; j < p; j++) {
+    for(int i = 0; i < p; i++) {
+      set_entry(T, slots[i], slots[j], network[i + (size_t) j * p]);
+    }
+  }
+
+  // Return pointer
+  return r_pointer;
+
+}
+
+// Interface with R (dense overlap matrix of slots)
+SEXP r_wto_tracker_matrix(SEXP r_pointer, SEXP r_slots, SEXP r_diagonal_zero) {
+
+  // Get tracker
+  wto_tracker* T = get_tracker(r_pointer);
+
+  // Get dimensions
+  int p = length(r_slots);
+  int* slots = INTEGER(r_slots);
+
+  // Initialize R result
+  SEXP r_output = PROTECT(allocMatrix(REALSXP, p, p));
+  double* output = REAL(r_output);
+
+  // Fill overlap
+  for(int j = 0; j < p; j++) {
+    for(int i = 0; i < p; i++) {
+      output[i + (size_t) j * p] = (i == j && LOGICAL(r_diagonal_zero)[0]) ?
+        0.0 : pair_wto(T, slots[i], slots[j]);
+    }
+  }
+
+  // Release protected SEXP objects
+  UNPROTECT(1);
+
+  // Return result
+  return r_output;
+
+}
@@ -6,23 +6,10 @@
 #include <Rinternals.h>
 #include <Rmath.h>
 #include "ziggurat.h"
+#include "ziggurat_tables.h"
 #include "xoshiro.h"
 #include "nanotime.h"
 
-// Set up static values for normal table
-static uint32_t kn[128];
-static double fn[128];
-static double wn[128];
-static int initialized = 0;
-
-// Function to initialize table
-void r4_nor_initialize(void) {
-  if (!initialized) {
-    r4_nor_setup(kn, fn, wn);
-    initialized = 1;
-  }
-}
-
 /*
 
  The base ziggurat.c code has been modified to support the use
@@ -48,45 +35,52 @@ void r4_nor_initialize(void) {
  Modified date: 30.07.2023
  Modified by: Alexander P. Christensen <alexpaulchristensen@gmail.com>
 
+ The original 128-layer, 32-bit `r4_nor` (and `r4_nor_setup`) has
+ been replaced with a 256-layer, 64-bit version (`r8_nor`):
+
+ +   tables are precomputed `static const` arrays (see
+     ziggurat_tables.h) so there is no `r4_nor_initialize`
+     and no shared mutable state -- `r8_nor` is safe to call
+     from multiple threads as long as each has its own state
+
+ +   each 64-bit draw provides the layer (8 bits), the sign
+     (1 bit), and a 52-bit magnitude so the rectangle test
+     is accepted ~99.3% of the time (~98.8% for 128 layers)
+
+ Modified date: 19.10.2026
+
  */
 
+// Uniform on the open interval (0, 1)
+// Avoids `log(0)` in the tail
+static inline double open_uniform(xoshiro256_state* state) {
+  return ((double) (next(state) >> 11) + 0.5) * 0x1.0p-53;
+}
+
 /******************************************************************************/
 
-double r4_nor ( xoshiro256_state* state, uint32_t kn[128], double fn[128], double wn[128] )
+double r8_nor ( xoshiro256_state* state )
 
   /******************************************************************************/
   /*
    Purpose:
 
-   r4_nor() returns a normally distributed single precision real value.
+   r8_nor() returns a normally distributed double precision real value.
 
    Discussion:
 
    The value returned is generated from a distribution with mean 0 and
    variance 1.
 
-   The underlying algorithm is the ziggurat method.
-
-   Before the first call to this function, the user must call R4_NOR_SETUP
-   to determine the values of KN, FN and WN.
-
-   Thanks to Chad Wagner, 21 July 2014, for noticing a bug of the form
-   if ( x * x <= y * y );   <-- Stray semicolon!
-   {
-   break;
-   }
+   The underlying algorithm is the ziggurat method with 256 layers.
 
    Licensing:
 
    This code is distributed under the GNU LGPL license.
 
-   Modified:
-
-   21 July 2014
-
    Author:
 
-   John Burkardt
+   John Burkardt (original 128-layer `r4_nor`)
 
    Reference:
 
@@ -97,167 +91,58 @@ double r4_nor ( xoshiro256_state* state, uint32_t kn[128], double fn[128], doubl
 
    Parameters:
 
-   Input/output, uint32_t *JSR, the seed.
-
-   Input, uint32_t KN[128], data computed by R4_NOR_SETUP.
+   Input/output, xoshiro256_state *STATE, the generator state.
 
-   Input, float FN[128], WN[128], data computed by R4_NOR_SETUP.
-
-   Output, float R4_NOR, a normally distributed random value.
+   Output, double R8_NOR, a normally distributed random value.
    */
 {
-  int hz;
-  uint32_t iz;
-  double x, y, value;
-
-  hz = ( int ) next ( state ); // cast may cause negative (and that's OK)
-  iz = ( hz & 127 );
-
-  if ( abs ( hz ) < kn[iz] ) {
-    value = ( double ) ( hz ) * wn[iz];
-  } else {
-    
-    for ( ; ; ) {
-      
-      if ( iz == 0 ) {
-        
-        for ( ; ; ) {
-          
-          x = - 0.2904764 * log ( xoshiro_uniform( state ) );
-          y = - log ( xoshiro_uniform( state ) );
-          if ( x * x <= y + y ) {
-            break;
-          }
-          
-        }
-        
-        value = ( hz <= 0 ) ? ( -R - x ) : ( R + x );
+  uint64_t u, magnitude;
+  int iz, negative;
+  double x, y;
 
-        break;
-        
-      }
+  for ( ; ; ) {
 
-      x = ( double ) ( hz ) * wn[iz];
+    // Split draw into layer, sign, and magnitude
+    u = next ( state );
+    iz = ( int ) ( u & 0xff );
+    negative = ( int ) ( ( u >> 8 ) & 0x1 );
+    magnitude = ( u >> 9 ) & 0x000fffffffffffffULL;
 
-      if ( 
-          fn[iz] + xoshiro_uniform( state ) * 
-          ( fn[iz-1] - fn[iz] ) < 
-          exp ( - 0.5 * x * x )
-      ) {
-        value = x;
-        break;
-      }
+    x = ( double ) magnitude * ZIGGURAT_WN[iz];
 
-      hz = ( int ) next ( state ); // cast may cause negative (and that's OK)
-      iz = ( hz & 127 );
-
-      if ( abs ( hz ) < kn[iz] ) {
-        value = ( double ) ( hz ) * wn[iz];
-        break;
-      }
-      
+    // Inside the rectangle (fast path)
+    if ( magnitude < ZIGGURAT_KN[iz] ) {
+      return negative ? -x : x;
     }
-    
-  }
 
-  return value;
-  
-}
-/******************************************************************************/
-
-void r4_nor_setup ( uint32_t kn[128], double fn[128], double wn[128] )
+    // Base layer (tail)
+    if ( iz == 0 ) {
 
-  /******************************************************************************/
-  /*
-   Purpose:
+      for ( ; ; ) {
 
-   r4_nor_setup() sets data needed by r4_nor().
-
-   Licensing:
-
-   This code is distributed under the GNU LGPL license.
-
-   Modified:
-
-   14 October 2013
-
-   Author:
-
-   John Burkardt
+        x = - ZIGGURAT_INV_R * log ( open_uniform( state ) );
+        y = - log ( open_uniform( state ) );
+        if ( x * x <= y + y ) {
+          break;
+        }
 
-   Reference:
+      }
 
-   George Marsaglia, Wai Wan Tsang,
-   The Ziggurat Method for Generating Random Variables,
-   Journal of Statistical Software,
-   Volume 5, Number 8, October 2000, seven pages.
+      return negative ? ( -ZIGGURAT_R - x ) : ( ZIGGURAT_R + x );
 
-   Parameters:
+    }
 
-   Output, uint32_t KN[128], data needed by R4_NOR.
+    // Wedge
+    if (
+        ZIGGURAT_FN[iz] + open_uniform( state ) *
+        ( ZIGGURAT_FN[iz-1] - ZIGGURAT_FN[iz] ) <
+        exp ( - 0.5 * x * x )
+    ) {
+      return negative ? -x : x;
+    }
 
-   Output, float FN[128], WN[128], data needed by R4_NOR.
-   */
-{
-  
-  /*
-    
-   Original code for comparison is provide below.
-   Constants were calculated by hand computing each
-   calculation
-    
-   
-      double dn = 3.442619855899;
-      int i;
-      const double m1 = 2147483648.0;
-      double q;
-      double tn = 3.442619855899;
-      const double vn = 9.91256303526217E-03;
-    
-      q = vn / exp ( - 0.5 * dn * dn );
-    
-      kn[0] = ( uint32_t ) ( ( dn / q ) * m1 );
-      kn[1] = 0;
-    
-      wn[0] = ( q / m1 );
-      wn[127] = ( dn / m1 );
-    
-      fn[0] = 1.0;
-      fn[127] = ( exp ( - 0.5 * dn * dn ) );
-    
-      for ( i = 126; 1 <= i; i-- )
-      {
-        dn = sqrt ( - 2.0 * log ( vn / dn + exp ( - 0.5 * dn * dn ) ) );
-        kn[i+1] = ( uint32_t ) ( ( dn / tn ) * m1 );
-        tn = dn;
-        fn[i] = ( exp ( - 0.5 * dn * dn ) );
-        wn[i] = ( dn / m1 );
-      }
-  */
-  
-  int i;
-  double dn = DN;
-  double tn = DN;
-
-  kn[0] = 1991057938;
-  kn[1] = 0;
-
-  wn[0] = 1.729040521542796563654E-09;
-  wn[127] = 1.603094793809112161398E-09;
-
-  fn[0] = 1.0;
-  fn[127] = 0.002669629083880925288704;
-
-  for ( i = 126; 1 <= i; i-- )
-  {
-    dn = sqrt ( - 2.0 * log ( VN / dn + exp ( - 0.5 * dn * dn ) ) );
-    kn[i+1] = ( uint32_t ) ( ( dn / tn ) * M1 );
-    tn = dn;
-    fn[i] = ( exp ( - 0.5 * dn * dn ) );
-    wn[i] = ( dn / M1 );
   }
 
-  return;
 }
 
 /******************************************************************************/
@@ -280,18 +165,15 @@ SEXP r_ziggurat(SEXP n, SEXP r_seed) {
   xoshiro256_state state;
   seed_xoshiro256(&state, seed_value);
 
-  // Initialize table (if necessary)
-  r4_nor_initialize();
-
   // Create R vector
   SEXP r_output = PROTECT(allocVector(REALSXP, n_values));
-  
+
   // Get a pointer to the double data of the R vector
   double* vec_data = REAL(r_output);
-  
+
   // Generate random numbers
   for(int i = 0; i < n_values; i++) {
-    vec_data[i] = r4_nor(&state, kn, fn, wn);
+    vec_data[i] = r8_nor(&state);
   }
 
   // Release protected SEXP objects
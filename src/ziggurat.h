@@ -1,11 +1,15 @@
+#ifndef ZIGGURAT_H
+#define ZIGGURAT_H
+
 #include "xoshiro.h"
 
-// Constants
-#define R 3.442620 // r
-#define DN 3.442619855899 // dn
-#define M1 2147483648.0 // m1
-#define VN 9.91256303526217E-03 // vn
+// Constants (256 layers)
+#define ZIGGURAT_R 3.6541528853610087963519472518 // r
+#define ZIGGURAT_INV_R 0.27366123732975827203338247596 // 1 / r
+#define ZIGGURAT_VN 4.928673233974654932e-03 // vn
+#define ZIGGURAT_M1 4503599627370496.0 // m1 (2^52)
 
 // Function prototypes
-void r4_nor_setup ( uint32_t kn[128], double fn[128], double wn[128] );
-double r4_nor ( xoshiro256_state* state, uint32_t kn[128], double fn[128], double wn[128] );
+double r8_nor ( xoshiro256_state* state );
+
+#endif /* ZIGGURAT_H */
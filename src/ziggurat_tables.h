@@ -0,0 +1,319 @@
+#ifndef ZIGGURAT_TABLES_H
+#define ZIGGURAT_TABLES_H
+
+#include <stdint.h>
+
+/*
+
+ Precomputed tables for the 256-layer, 64-bit ziggurat in `ziggurat.c`
+
+ The tables are read-only so `r8_nor` needs no initialization call
+ and can be used by multiple threads at once (each with their own
+ xoshiro256++ state)
+
+ Tables were generated with `long double` precision using the
+ recursion from Marsaglia and Tsang (2000) with 256 layers and
+ 52-bit magnitudes (M1 = 2^52). The area of each layer (VN) was
+ computed from R so that the top layer closes at zero:
+
+   VN = R * exp(-R^2 / 2) + sqrt(pi / 2) * erfc(R / sqrt(2))
+
+ Original code for generating the tables is provided below.
+ Tables should only need to be regenerated if the constants
+ in `ziggurat.h` change
+
+    long double dn = ZIGGURAT_R, tn = ZIGGURAT_R;
+    long double q = ZIGGURAT_VN / expl(-0.5L * dn * dn);
+
+    kn[0] = (uint64_t) ((dn / q) * ZIGGURAT_M1);
+    kn[1] = 0;
+
+    wn[0] = (double) (q / ZIGGURAT_M1);
+    wn[255] = (double) (dn / ZIGGURAT_M1);
+
+    fn[0] = 1.0;
+    fn[255] = (double) expl(-0.5L * dn * dn);
+
+    for (int i = 254; 1 <= i; i--) {
+      dn = sqrtl(-2.0L * logl(ZIGGURAT_VN / dn + expl(-0.5L * dn * dn)));
+      kn[i + 1] = (uint64_t) ((dn / tn) * ZIGGURAT_M1);
+      tn = dn;
+      fn[i] = (double) expl(-0.5L * dn * dn);
+      wn[i] = (double) (dn / ZIGGURAT_M1);
+    }
+
+ Modified date: 19.10.2026
+
+*/
+
+// Number of layers
+#define ZIGGURAT_LAYERS 256
+
+static const uint64_t ZIGGURAT_KN[ZIGGURAT_LAYERS] = {
+  0xef33d8025ef65ULL,  0x0000000000000ULL,  0xc08be98fbc6c6ULL,
+  0xda354fabd814bULL,  0xe51f67ec1eeefULL,  0xeb255e9d3f780ULL,
+  0xeef4b817ecabaULL,  0xf19470afa44acULL,  0xf37ed61ffcb17ULL,
+  0xf4f469561255bULL,  0xf61a5e41ba396ULL,  0xf707a755396a4ULL,
+  0xf7cb2ec28449bULL,  0xf86f10c6357d3ULL,  0xf8fa6578325ddULL,
+  0xf9724c74dd0daULL,  0xf9da907dbf508ULL,  0xfa360f581fa72ULL,
+  0xfa86fde5b4bf8ULL,  0xfacf160d354dcULL,  0xfb0fb6718b90eULL,
+  0xfb49f8d5374c5ULL,  0xfb7ec2366fe77ULL,  0xfbaece9a1e50cULL,
+  0xfbdab9d040bedULL,  0xfc03060ff6c57ULL,  0xfc2821037a248ULL,
+  0xfc4a67ae25bd1ULL,  0xfc6a2977aee30ULL,  0xfc87aa92896a4ULL,
+  0xfca325e4bde85ULL,  0xfcbcce902231aULL,  0xfcd4d12f839c4ULL,
+  0xfceb54d8fec99ULL,  0xfd007bf1dc930ULL,  0xfd1464dd6c4e5ULL,
+  0xfd272a8e2f450ULL,  0xfd38e4ff0c91eULL,  0xfd49a9990b479ULL,
+  0xfd598b8920f52ULL,  0xfd689c08e99ecULL,  0xfd76ea9c8e832ULL,
+  0xfd848547b08e8ULL,  0xfd9178bad2c8bULL,  0xfd9dd07a7add2ULL,
+  0xfda9970105e8bULL,  0xfdb4d5dc02e1fULL,  0xfdbf95c5bfcd0ULL,
+  0xfdc9debb99a7dULL,  0xfdd3b8118729dULL,  0xfddd288342f8fULL,
+  0xfde6364369f63ULL,  0xfdeee708d514eULL,  0xfdf7401a6b42eULL,
+  0xfdff46599ed3eULL,  0xfe06fe4bc24f1ULL,  0xfe0e6c225a258ULL,
+  0xfe1593c28b84bULL,  0xfe1c78cbc3f98ULL,  0xfe231e9db1ca9ULL,
+  0xfe29885da1b91ULL,  0xfe2fb8fb54186ULL,  0xfe35b33558d4aULL,
+  0xfe3b799d0002aULL,  0xfe410e99ead7eULL,  0xfe46746d47734ULL,
+  0xfe4bad34c095bULL,  0xfe50baed29524ULL,  0xfe559f74ebc77ULL,
+  0xfe5a5c8e41212ULL,  0xfe5ef3e138689ULL,  0xfe6366fd91077ULL,
+  0xfe67b75c6d578ULL,  0xfe6be661e11aaULL,  0xfe6ff55e5f4f2ULL,
+  0xfe73e5900a701ULL,  0xfe77b823e9e39ULL,  0xfe7b6e37070a1ULL,
+  0xfe7f08d774242ULL,  0xfe8289053f08cULL,  0xfe85efb35173bULL,
+  0xfe893dc840864ULL,  0xfe8c741f0cebcULL,  0xfe8f9387d4ef6ULL,
+  0xfe929cc879b1cULL,  0xfe95909d388eaULL,  0xfe986fb939aa1ULL,
+  0xfe9b3ac714865ULL,  0xfe9df2694b6d5ULL,  0xfea0973abe67bULL,
+  0xfea329cf166a4ULL,  0xfea5aab32952cULL,  0xfea81a6d57419ULL,
+  0xfeaa797de1cefULL,  0xfeacc85f3d91fULL,  0xfeaf07865e63cULL,
+  0xfeb13762fec12ULL,  0xfeb3585fe2a4aULL,  0xfeb56ae3162b4ULL,
+  0xfeb76f4e284f9ULL,  0xfeb965fe62013ULL,  0xfebb4f4cf9d7cULL,
+  0xfebd2b8f449cfULL,  0xfebefb16e2e3dULL,  0xfec0be31ebde8ULL,
+  0xfec2752b15a14ULL,  0xfec42049dafd3ULL,  0xfec5bfd29f196ULL,
+  0xfec75406ceef4ULL,  0xfec8dd2500cb4ULL,  0xfeca5b6911f10ULL,
+  0xfecbcf0c427feULL,  0xfecd38454fb15ULL,  0xfece97488c8b3ULL,
+  0xfecfec47f91b7ULL,  0xfed1377358528ULL,  0xfed278f844903ULL,
+  0xfed3b10242f4cULL,  0xfed4dfbad586dULL,  0xfed605498c3dcULL,
+  0xfed721d414fe8ULL,  0xfed8357e4a981ULL,  0xfed9406a42cc8ULL,
+  0xfeda42b85b704ULL,  0xfedb3c8746ab3ULL,  0xfedc2df416652ULL,
+  0xfedd171a46e52ULL,  0xfeddf813c8ad2ULL,  0xfeded0f90997fULL,
+  0xfedfa1e0fd413ULL,  0xfee06ae124bc4ULL,  0xfee12c0d95a06ULL,
+  0xfee1e579006dfULL,  0xfee29734b6524ULL,  0xfee34150ae4bbULL,
+  0xfee3e3db89b3cULL,  0xfee47ee2982f3ULL,  0xfee51271db086ULL,
+  0xfee59e9407f41ULL,  0xfee623528b42dULL,  0xfee6a0b5897f0ULL,
+  0xfee716c3e077aULL,  0xfee7858327b81ULL,  0xfee7ecf7b06b9ULL,
+  0xfee84d2484ab2ULL,  0xfee8a60b66342ULL,  0xfee8f7accc851ULL,
+  0xfee94207e25daULL,  0xfee9851a829ebULL,  0xfee9c0e13485bULL,
+  0xfee9f557273f3ULL,  0xfeea22762ccaeULL,  0xfeea4836b42abULL,
+  0xfeea668fc2d71ULL,  0xfeea7d76ed6f9ULL,  0xfeea8ce04fa0aULL,
+  0xfeea94be8333bULL,  0xfeea95029640fULL,  0xfeea8d9c0075dULL,
+  0xfeea7e7897653ULL,  0xfeea678481d24ULL,  0xfeea48aa29e82ULL,
+  0xfeea21d22e4d9ULL,  0xfee9f2e352024ULL,  0xfee9bbc26af2eULL,
+  0xfee97c524f2e3ULL,  0xfee93473c0a39ULL,  0xfee8e40557515ULL,
+  0xfee88ae369c79ULL,  0xfee828e7f3dfcULL,  0xfee7bdea7b887ULL,
+  0xfee749bff37ffULL,  0xfee6cc3a9bd5eULL,  0xfee64529e007fULL,
+  0xfee5b45a32888ULL,  0xfee51994e57b5ULL,  0xfee474a0006ceULL,
+  0xfee3c53e12c4fULL,  0xfee30b2e02ad7ULL,  0xfee2462ad8204ULL,
+  0xfee175eb83c59ULL,  0xfee09a22a1447ULL,  0xfedfb27e349cbULL,
+  0xfedebea76216cULL,  0xfeddbe422047dULL,  0xfedcb0ece39d3ULL,
+  0xfedb964042cf3ULL,  0xfeda6dce938c9ULL,  0xfed937237e98cULL,
+  0xfed7f1c38a836ULL,  0xfed69d2b9c02aULL,  0xfed538d06adffULL,
+  0xfed3c41dea422ULL,  0xfed23e76a2fd7ULL,  0xfed0a732fe643ULL,
+  0xfecefda07fe33ULL,  0xfecd4100eb7b8ULL,  0xfecb708956eb4ULL,
+  0xfec98b61230c0ULL,  0xfec790a0da978ULL,  0xfec57f50f31fdULL,
+  0xfec356686c961ULL,  0xfec114cb4b334ULL,  0xfebeb948e6fd0ULL,
+  0xfebc429a0b691ULL,  0xfeb9af5ee0cdcULL,  0xfeb6fe1c98542ULL,
+  0xfeb42d3ad1f9eULL,  0xfeb13b00b2d4bULL,  0xfeae2591a02e8ULL,
+  0xfeaaeae992256ULL,  0xfea788d8ee326ULL,  0xfea3fcffd73e5ULL,
+  0xfea044c8dd9f6ULL,  0xfe9c5d62f563aULL,  0xfe9843ba947a3ULL,
+  0xfe93f471d4728ULL,  0xfe8f6bd76c5d6ULL,  0xfe8aa5dc4e8e6ULL,
+  0xfe859e07ab1eaULL,  0xfe804f690a93fULL,  0xfe7ab488233bfULL,
+  0xfe74c751f6aa5ULL,  0xfe6e8102aa201ULL,  0xfe67da0b6abd8ULL,
+  0xfe60c9f38307dULL,  0xfe5947338f742ULL,  0xfe51470977280ULL,
+  0xfe48bd436f457ULL,  0xfe3f9bffd1e37ULL,  0xfe35d35eeb19bULL,
+  0xfe2b5122fe4fdULL,  0xfe20003995557ULL,  0xfe13c82788314ULL,
+  0xfe068c4ee67afULL,  0xfdf82b02b71aaULL,  0xfde87c57efeaaULL,
+  0xfdd7509c63bfdULL,  0xfdc46e529bf12ULL,  0xfdaf8f82e0282ULL,
+  0xfd985e1b2ba75ULL,  0xfd7e6ef48cf04ULL,  0xfd613adbd650bULL,
+  0xfd40149e2f011ULL,  0xfd1a1a7b4c7acULL,  0xfcee204761f9eULL,
+  0xfcba8d85e11b1ULL,  0xfc7d26ecd2d22ULL,  0xfc32b2f1e22ecULL,
+  0xfbd6581c0b839ULL,  0xfb606c4005433ULL,  0xfac40582a2873ULL,
+  0xf9e971e014597ULL,  0xf89fa48a41dfbULL,  0xf66c5f7f0302cULL,
+  0xf1a5a4b331c49ULL
+};
+
+static const double ZIGGURAT_WN[ZIGGURAT_LAYERS] = {
+  8.68362706080131504e-16,  4.77933017572781818e-17,  6.35435241740531284e-17,
+  7.45487048124773695e-17,  8.32936681579313424e-17,  9.06806040505951556e-17,
+  9.71486007656779389e-17,  1.02947503142410463e-16,  1.08234302884477111e-16,
+  1.13114701961090579e-16,  1.17663594570229458e-16,  1.21936172787143855e-16,
+  1.25974399146371125e-16,  1.29810998862640513e-16,  1.33472037368241425e-16,
+  1.36978648425712230e-16,  1.40348230012424018e-16,  1.43595294520569652e-16,
+  1.46732087423644416e-16,  1.49769046683910589e-16,  1.52715150035962202e-16,
+  1.55578181694607861e-16,  1.58364940092909076e-16,  1.61081401752749526e-16,
+  1.63732852039698754e-16,  1.66323990584208550e-16,  1.68859017086766161e-16,
+  1.71341701765596780e-16,  1.73775443658648791e-16,  1.76163319230010157e-16,
+  1.78508123169767470e-16,  1.80812402857991695e-16,  1.83078487648267699e-16,
+  1.85308513886180387e-16,  1.87504446393738989e-16,  1.89668097007747769e-16,
+  1.91801140648386395e-16,  1.93905129306251234e-16,  1.95981504266288392e-16,
+  1.98031606831281912e-16,  2.00056687762733448e-16,  2.02057915620716662e-16,
+  2.04036384154802242e-16,  2.05993118874037211e-16,  2.07929082904140321e-16,
+  2.09845182223703665e-16,  2.11742270357603567e-16,  2.13621152594498804e-16,
+  2.15482589785814704e-16,  2.17327301775643798e-16,  2.19155970504272856e-16,
+  2.20969242822353324e-16,  2.22767733047895683e-16,  2.24552025294143750e-16,
+  2.26322675592856984e-16,  2.28080213834501904e-16,  2.29825145544247036e-16,
+  2.31557953510408234e-16,  2.33279099280043758e-16,  2.34989024534709748e-16,
+  2.36688152357916235e-16,  2.38376888404542632e-16,  2.40055621981350775e-16,
+  2.41724727046750400e-16,  2.43384563137110434e-16,  2.45035476226149688e-16,
+  2.46677799523270695e-16,  2.48311854216108916e-16,  2.49937950162045440e-16,
+  2.51556386532965934e-16,  2.53167452417135975e-16,  2.54771427381694615e-16,
+  2.56368581998939832e-16,  2.57959178339286822e-16,  2.59543470433517169e-16,
+  2.61121704706702087e-16,  2.62694120385972713e-16,  2.64260949884119099e-16,
+  2.65822419160830878e-16,  2.67378748063236477e-16,  2.68930150647261740e-16,
+  2.70476835481199667e-16,  2.72019005932773355e-16,  2.73556860440868057e-16,
+  2.75090592773016812e-16,  2.76620392269639180e-16,  2.78146444075954509e-16,
+  2.79668929362423104e-16,  2.81188025534502173e-16,  2.82703906432448022e-16,
+  2.84216742521840705e-16,  2.85726701075460199e-16,  2.87233946347098044e-16,
+  2.88738639737848241e-16,  2.90240939955384283e-16,  2.91741003166694603e-16,
+  2.93238983144718263e-16,  2.94735031409293588e-16,  2.96229297362806697e-16,
+  2.97721928420902990e-16,  2.99213070138601406e-16,  3.00702866332133202e-16,
+  3.02191459196806251e-16,  3.03678989421180283e-16,  3.05165596297821972e-16,
+  3.06651417830895550e-16,  3.08136590840829816e-16,  3.09621251066292352e-16,
+  3.11105533263689395e-16,  3.12589571304399991e-16,  3.14073498269944765e-16,
+  3.15557446545280212e-16,  3.17041547910403000e-16,  3.18525933630440747e-16,
+  3.20010734544401236e-16,  3.21496081152744804e-16,  3.22982103703941607e-16,
+  3.24468932280169827e-16,  3.25956696882307937e-16,  3.27445527514370770e-16,
+  3.28935554267537066e-16,  3.30426907403912937e-16,  3.31919717440175283e-16,
+  3.33414115231237295e-16,  3.34910232054077895e-16,  3.36408199691876557e-16,
+  3.37908150518595029e-16,  3.39410217584149013e-16,  3.40914534700312702e-16,
+  3.42421236527501915e-16,  3.43930458662583183e-16,  3.45442337727858451e-16,
+  3.46957011461378452e-16,  3.48474618808741469e-16,  3.49995300016538198e-16,
+  3.51519196727607540e-16,  3.53046452078274108e-16,  3.54577210797743671e-16,
+  3.56111619309838942e-16,  3.57649825837265150e-16,  3.59191980508603143e-16,
+  3.60738235468235335e-16,  3.62288744989419349e-16,  3.63843665590734636e-16,
+  3.65403156156137144e-16,  3.66967378058870238e-16,  3.68536495289491549e-16,
+  3.70110674588289983e-16,  3.71690085582382396e-16,  3.73274900927794451e-16,
+  3.74865296456848967e-16,  3.76461451331202918e-16,  3.78063548200896087e-16,
+  3.79671773369794475e-16,  3.81286316967837788e-16,  3.82907373130524367e-16,
+  3.84535140186095956e-16,  3.86169820850914927e-16,  3.87811622433558721e-16,
+  3.89460757048192621e-16,  3.91117441837820542e-16,  3.92781899208054203e-16,
+  3.94454357072087761e-16,  3.96135049107613543e-16,  3.97824215026468309e-16,
+  3.99522100857856502e-16,  4.01228959246062957e-16,  4.02945049763632842e-16,
+  4.04670639241075044e-16,  4.06406002114225039e-16,  4.08151420790493873e-16,
+  4.09907186035326643e-16,  4.11673597380302521e-16,  4.13450963554423501e-16,
+  4.15239602940268686e-16,  4.17039844056831440e-16,  4.18852026071011082e-16,
+  4.20676499339901412e-16,  4.22513625986204839e-16,  4.24363780509307747e-16,
+  4.26227350434779810e-16,  4.28104737005311666e-16,  4.29996355916383230e-16,
+  4.31902638100262945e-16,  4.33824030562279080e-16,  4.35760997273684901e-16,
+  4.37714020125858747e-16,  4.39683599951052137e-16,  4.41670257615420398e-16,
+  4.43674535190656727e-16,  4.45696997211204307e-16,  4.47738232024753387e-16,
+  4.49798853244554968e-16,  4.51879501313005876e-16,  4.53980845187003401e-16,
+  4.56103584156742305e-16,  4.58248449810956766e-16,  4.60416208163115380e-16,
+  4.62607661954784666e-16,  4.64823653154320836e-16,  4.67065065671263256e-16,
+  4.69332828309332989e-16,  4.71627917983835327e-16,  4.73951363232586912e-16,
+  4.76304248053313935e-16,  4.78687716104872481e-16,  4.81102975314741918e-16,
+  4.83551302941152712e-16,  4.86034051145081294e-16,  4.88552653135360442e-16,
+  4.91108629959527054e-16,  4.93703598024033553e-16,  4.96339277440398824e-16,
+  4.99017501309182246e-16,  5.01740226071809045e-16,  5.04509543081872847e-16,
+  5.07327691573354306e-16,  5.10197073234156184e-16,  5.13120268630678373e-16,
+  5.16100055774322825e-16,  5.19139431175769958e-16,  5.22241633800023527e-16,
+  5.25410172417759733e-16,  5.28648856950494511e-16,  5.31961834533840038e-16,
+  5.35353631181649688e-16,  5.38829200133405320e-16,  5.42393978220171234e-16,
+  5.46053951907478140e-16,  5.49815735089281411e-16,  5.53686661246787600e-16,
+  5.57674893292657746e-16,  5.61789555355541666e-16,  5.66040892008242315e-16,
+  5.70440462129139007e-16,  5.75001376891989622e-16,  5.79738594572459464e-16,
+  5.84669289345547999e-16,  5.89813317647790041e-16,  5.95193814964144514e-16,
+  6.00837969627190931e-16,  6.06778040933344851e-16,  6.13052720872528061e-16,
+  6.19708989458162555e-16,  6.26804696330128341e-16,  6.34412240712750500e-16,
+  6.42623965954805442e-16,  6.51560331734499258e-16,  6.61382788509766317e-16,
+  6.72315046250558564e-16,  6.84680341756425876e-16,  6.98971833638761995e-16,
+  7.15999493483066422e-16,  7.37242430179879792e-16,  7.65893637080557177e-16,
+  8.11384933765648419e-16
+};
+
+static const double ZIGGURAT_FN[ZIGGURAT_LAYERS] = {
+  1.00000000000000000e+00,  9.77101701267670819e-01,  9.59879091800105999e-01,
+  9.45198953442299095e-01,  9.32060075959229906e-01,  9.19991505039346458e-01,
+  9.08726440052130324e-01,  8.98095921898342864e-01,  8.87984660755832822e-01,
+  8.78309655808916845e-01,  8.69008688036856491e-01,  8.60033621196331088e-01,
+  8.51346258458677507e-01,  8.42915653112203733e-01,  8.34716292986882991e-01,
+  8.26726833946220929e-01,  8.18929191603701923e-01,  8.11307874312655719e-01,
+  8.03849483170963830e-01,  7.96542330422958411e-01,  7.89376143566024036e-01,
+  7.82341832654801950e-01,  7.75431304981186620e-01,  7.68637315798485710e-01,
+  7.61953346836794831e-01,  7.55373506507095671e-01,  7.48892447219156376e-01,
+  7.42505296340150611e-01,  7.36207598126862095e-01,  7.29995264561475676e-01,
+  7.23864533468629667e-01,  7.17811932630721516e-01,  7.11834248878247977e-01,
+  7.05928501332753755e-01,  7.00091918136511171e-01,  6.94321916126116268e-01,
+  6.88616083004671253e-01,  6.82972161644994302e-01,  6.77388036218773082e-01,
+  6.71861719897081655e-01,  6.66391343908749767e-01,  6.60975147776662775e-01,
+  6.55611470579696931e-01,  6.50298743110816369e-01,  6.45035480820821960e-01,
+  6.39820277453056141e-01,  6.34651799287623164e-01,  6.29528779924836246e-01,
+  6.24450015547026061e-01,  6.19414360605833991e-01,  6.14420723888913445e-01,
+  6.09468064925773101e-01,  6.04555390697467332e-01,  5.99681752619124819e-01,
+  5.94846243767986893e-01,  5.90047996332825453e-01,  5.85286179263370898e-01,
+  5.80559996100790343e-01,  5.75868682972353163e-01,  5.71211506735252672e-01,
+  5.66587763256163890e-01,  5.61996775814523897e-01,  5.57437893618765501e-01,
+  5.52910490425831846e-01,  5.48413963255265369e-01,  5.43947731190025818e-01,
+  5.39511234256951577e-01,  5.35103932380457170e-01,  5.30725304403661502e-01,
+  5.26374847171684035e-01,  5.22052074672321398e-01,  5.17756517229755908e-01,
+  5.13487720747326515e-01,  5.09245245995747609e-01,  5.05028667943467902e-01,
+  5.00837575126148349e-01,  4.96671569052489326e-01,  4.92530263643868149e-01,
+  4.88413284705457584e-01,  4.84320269426682881e-01,  4.80250865909046420e-01,
+  4.76204732719505475e-01,  4.72181538467729756e-01,  4.68180961405693208e-01,
+  4.64202689048173911e-01,  4.60246417812842479e-01,  4.56311852678716101e-01,
+  4.52398706861848243e-01,  4.48506701507202732e-01,  4.44635565395739119e-01,
+  4.40785034665803765e-01,  4.36954852547985328e-01,  4.33144769112652095e-01,
+  4.29354541029441261e-01,  4.25583931338021804e-01,  4.21832709229495728e-01,
+  4.18100649837847949e-01,  4.14387534040890904e-01,  4.10693148270187991e-01,
+  4.07017284329473150e-01,  4.03359739221114288e-01,  3.99720314980197000e-01,
+  3.96098818515832174e-01,  3.92495061459315397e-01,  3.88908860018788549e-01,
+  3.85340034840077061e-01,  3.81788410873393436e-01,  3.78253817245618962e-01,
+  3.74736087137890861e-01,  3.71235057668239221e-01,  3.67750569779032255e-01,
+  3.64282468129003723e-01,  3.60830600989647754e-01,  3.57394820145780223e-01,
+  3.53974980800076555e-01,  3.50570941481405884e-01,  3.47182563956793477e-01,
+  3.43809713146850549e-01,  3.40452257044521645e-01,  3.37110066637005878e-01,
+  3.33783015830718233e-01,  3.30470981379163420e-01,  3.27173842813601290e-01,
+  3.23891482376391038e-01,  3.20623784956905300e-01,  3.17370638029913499e-01,
+  3.14131931596337066e-01,  3.10907558126286343e-01,  3.07697412504291890e-01,
+  3.04501391976649827e-01,  3.01319396100802883e-01,  2.98151326696685315e-01,
+  2.94997087799961644e-01,  2.91856585617094988e-01,  2.88729728482182701e-01,
+  2.85616426815501590e-01,  2.82516593083707412e-01,  2.79430141761637718e-01,
+  2.76356989295668098e-01,  2.73297054068576906e-01,  2.70250256365875186e-01,
+  2.67216518343561138e-01,  2.64195763997260802e-01,  2.61187919132720825e-01,
+  2.58192911337618902e-01,  2.55210669954661684e-01,  2.52241126055941900e-01,
+  2.49284212418528245e-01,  2.46339863501263634e-01,  2.43408015422750118e-01,
+  2.40488605940500394e-01,  2.37581574431237952e-01,  2.34686861872329899e-01,
+  2.31804410824338586e-01,  2.28934165414680230e-01,  2.26076071322380195e-01,
+  2.23230075763917457e-01,  2.20396127480151943e-01,  2.17574176724331131e-01,
+  2.14764175251173584e-01,  2.11966076307030155e-01,  2.09179834621124994e-01,
+  2.06405406397880714e-01,  2.03642749310334853e-01,  2.00891822494656563e-01,
+  1.98152586545775111e-01,  1.95425003514134277e-01,  1.92709036903589120e-01,
+  1.90004651670464958e-01,  1.87311814223800249e-01,  1.84630492426799270e-01,
+  1.81960655599522542e-01,  1.79302274522847666e-01,  1.76655321443734997e-01,
+  1.74019770081838748e-01,  1.71395595637505949e-01,  1.68782774801211510e-01,
+  1.66181285764482045e-01,  1.63591108232365695e-01,  1.61012223437511065e-01,
+  1.58444614155924313e-01,  1.55888264724479197e-01,  1.53343161060262828e-01,
+  1.50809290681845676e-01,  1.48286642732574525e-01,  1.45775208005994028e-01,
+  1.43274978973513406e-01,  1.40785949814444700e-01,  1.38308116448550705e-01,
+  1.35841476571253728e-01,  1.33386029691669128e-01,  1.30941777173644303e-01,
+  1.28508722279999515e-01,  1.26086870220185859e-01,  1.23676228201596544e-01,
+  1.21276805484790209e-01,  1.18888613442909977e-01,  1.16511665625610800e-01,
+  1.14145977827838349e-01,  1.11791568163838007e-01,  1.09448457146811631e-01,
+  1.07116667774683635e-01,  1.04796225622486902e-01,  1.02487158941935080e-01,
+  1.00189498768809809e-01,  9.79032790388622842e-02,  9.56285367130088187e-02,
+  9.33653119126908598e-02,  9.11136480663736342e-02,  8.88735920682757891e-02,
+  8.66451944505579608e-02,  8.44285095703533744e-02,  8.22235958132028627e-02,
+  8.00305158146630558e-02,  7.78493367020960392e-02,  7.56801303589270669e-02,
+  7.35229737139812684e-02,  7.13779490588903748e-02,  6.92451443970067693e-02,
+  6.71246538277884969e-02,  6.50165779712428421e-02,  6.29210244377581135e-02,
+  6.08381083495398642e-02,  5.87679529209337581e-02,  5.67106901062028948e-02,
+  5.46664613248889139e-02,  5.26354182767921758e-02,  5.06177238609477609e-02,
+  4.86135532158685213e-02,  4.66230949019303675e-02,  4.46465522512944427e-02,
+  4.26841449164744313e-02,  4.07361106559409325e-02,  3.88027074045261128e-02,
+  3.68842156885672845e-02,  3.49809414617160835e-02,  3.30932194585785225e-02,
+  3.12214171919202449e-02,  2.93659397581333137e-02,  2.75272356696030819e-02,
+  2.57058040085488965e-02,  2.39022033057958820e-02,  2.21170627073088641e-02,
+  2.03510962300445172e-02,  1.86051212757246433e-02,  1.68800831525431662e-02,
+  1.51770883079353248e-02,  1.34974506017398795e-02,  1.18427578579078877e-02,
+  1.02149714397014712e-02,  8.61658276939873159e-03,  7.05087547137322676e-03,
+  5.52240329925099676e-03,  4.03797259336303050e-03,  2.60907274610216273e-03,
+  1.26028593049859754e-03
+};
+
+#endif /* ZIGGURAT_TABLES_H */